@@ -0,0 +1,100 @@
+/*!
+ * @file ColumnStates.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "ColumnStates.hpp"
+
+#include "include/Configurator.hpp"
+#include "include/ConfiguredModule.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Nextsim {
+
+void ColumnStates::configureModules()
+{
+    static bool configured = false;
+    if (configured)
+        return;
+    Configurator::clearStreams();
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+    ElementData().configure();
+    configured = true;
+}
+
+std::vector<ElementData> ColumnStates::generate(unsigned seed)
+{
+    configureModules();
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    auto between = [&](double low, double high) { return low + (high - low) * uniform(gen); };
+    std::normal_distribution<double> normal(0, 1);
+    std::weibull_distribution<double> windSpeed(2, 8);
+
+    const double oceanFreezing = -1.8;
+
+    std::vector<ElementData> columns;
+    columns.reserve(nColumns);
+    for (int i = 0; i < nColumns; ++i) {
+        columns.emplace_back(1);
+        ElementData& data = columns.back();
+
+        // A quarter of open water, the rest split between the marginal ice zone and pack ice
+        const double regime = uniform(gen);
+        double cice = 0;
+        double hTrue = 0;
+        double hSnowTrue = 0;
+        double tair;
+        if (regime < 0.25) {
+            tair = -2 + 4 * normal(gen);
+        } else if (regime < 0.4) {
+            cice = between(0.05, 0.8);
+            hTrue = between(0.1, 1);
+            hSnowTrue = between(0, 0.1);
+            tair = -8 + 5 * normal(gen);
+        } else {
+            cice = between(0.9, 1);
+            hTrue = 1.8 * std::exp(0.4 * normal(gen));
+            hSnowTrue = between(0, 0.4);
+            tair = -20 + 8 * normal(gen);
+        }
+        tair = std::min(tair, 2.);
+        const double sst
+            = (cice > 0) ? oceanFreezing + between(0, 0.2) : between(oceanFreezing, 4);
+        // Ice surfaces are warmer than the air above them, and do not melt
+        const double tice = (cice > 0) ? std::min(tair + between(0, 5), 0.) : oceanFreezing;
+
+        data = PrognosticGenerator()
+                   .hice(cice * hTrue)
+                   .cice(cice)
+                   .hsnow(cice * hSnowTrue)
+                   .sst(sst)
+                   .sss(33 + normal(gen))
+                   .tice({ tice });
+
+        data.setAirTemperature(tair);
+        data.setDewPoint2m(tair - between(0.5, 4));
+        data.setAirPressure(101000 + 1200 * normal(gen));
+        data.setMixingRatio(-1);
+        // Two fifths of the columns are in darkness
+        data.setIncomingShortwave((uniform(gen) < 0.4) ? 0 : between(0, 400));
+        data.setIncomingLongwave(between(150, 320));
+        data.setMixedLayerDepth(between(10, 60));
+        data.setSnowfall((uniform(gen) < 0.7) ? 0 : between(0, 1e-4));
+        data.windSpeed() = windSpeed(gen);
+
+        data.updateDerivedData(data, data, data);
+        data.calculate(data, data, data);
+    }
+    return columns;
+}
+
+} /* namespace Nextsim */
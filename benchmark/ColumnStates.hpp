@@ -0,0 +1,46 @@
+/*!
+ * @file ColumnStates.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef BENCHMARK_COLUMNSTATES_HPP
+#define BENCHMARK_COLUMNSTATES_HPP
+
+#include "include/ElementData.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class generating the column states over which the kernels are benchmarked.
+ *
+ * @details The columns are drawn from a mixture of open water, marginal ice
+ * zone and pack ice, with forcing typical of each, so that the benchmarks
+ * follow the branches taken in a real domain rather than one uniform state.
+ * The states are reproducible for a given seed and standard library.
+ */
+class ColumnStates {
+public:
+    //! The number of columns processed by each benchmark
+    static const int nColumns = 4096;
+
+    /*!
+     * @brief Returns a new set of columns, on which the column physics has
+     * been calculated once.
+     *
+     * @details The modules are set to their defaults and configured on the
+     * first call.
+     *
+     * @param seed The seed of the random number generator.
+     */
+    static std::vector<ElementData> generate(unsigned seed = 1);
+
+    //! Sets all modules to their defaults and configures them, once only.
+    static void configureModules();
+};
+
+} /* namespace Nextsim */
+
+#endif /* BENCHMARK_COLUMNSTATES_HPP */
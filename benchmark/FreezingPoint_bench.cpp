@@ -0,0 +1,40 @@
+/*!
+ * @file FreezingPoint_bench.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+#include "include/LinearFreezing.hpp"
+#include "include/UnescoFreezing.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Freezing point implementations", "[IFreezingPoint]")
+{
+    const std::vector<ElementData> columns = ColumnStates::generate();
+
+    LinearFreezing linear;
+    UnescoFreezing unesco;
+    // Benchmark through the interface, as PrognosticData calls the freezing point
+    const IFreezingPoint* implementations[] = { &linear, &unesco };
+    const char* names[] = { "LinearFreezing", "UnescoFreezing" };
+
+    for (int i = 0; i < 2; ++i) {
+        const IFreezingPoint& freezingPoint = *implementations[i];
+        BENCHMARK(names[i])
+        {
+            double sum = 0;
+            for (auto& data : columns) {
+                sum += freezingPoint(data.seaSurfaceSalinity());
+            }
+            return sum;
+        };
+    }
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,44 @@
+/*!
+ * @file IceAlbedo_bench.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+#include "include/CCSMIceAlbedo.hpp"
+#include "include/Configured.hpp"
+#include "include/SMU2IceAlbedo.hpp"
+#include "include/SMUIceAlbedo.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Ice albedo implementations", "[IIceAlbedo]")
+{
+    const std::vector<ElementData> columns = ColumnStates::generate();
+
+    SMUIceAlbedo smu;
+    SMU2IceAlbedo smu2;
+    CCSMIceAlbedo ccsm;
+    // Benchmark through the interface, as the column physics calls the albedo
+    IIceAlbedo* implementations[] = { &smu, &smu2, &ccsm };
+    const char* names[] = { "SMUIceAlbedo", "SMU2IceAlbedo", "CCSMIceAlbedo" };
+
+    for (int i = 0; i < 3; ++i) {
+        tryConfigure(implementations[i]);
+        IIceAlbedo& albedo = *implementations[i];
+        BENCHMARK(names[i])
+        {
+            double sum = 0;
+            for (auto& data : columns) {
+                sum += albedo.albedo(data.iceTemperature(0), data.snowTrueThickness());
+            }
+            return sum;
+        };
+    }
+}
+
+} /* namespace Nextsim */
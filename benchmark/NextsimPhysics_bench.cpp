@@ -0,0 +1,102 @@
+/*!
+ * @file NextsimPhysics_bench.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+#include "include/ExternalData.hpp"
+#include "include/NextsimPhysics.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("NextsimPhysics column kernels", "[NextsimPhysics]")
+{
+    std::vector<ElementData> columns = ColumnStates::generate();
+
+    BENCHMARK("NextsimPhysics::calculate")
+    {
+        for (auto& data : columns) {
+            data.calculate(data, data, data);
+        }
+        return columns.front().updatedIceTrueThickness();
+    };
+
+    // The forcing of the columns as it was, and a step later, with a changed pressure
+    std::vector<ExternalData> forcing[2];
+    for (auto& data : columns) {
+        forcing[0].push_back(static_cast<const ExternalData&>(data));
+        forcing[1].push_back(static_cast<const ExternalData&>(data));
+        forcing[1].back().setAirPressure(forcing[1].back().airPressure() + 100);
+    }
+
+    BENCHMARK_ADVANCED("updateDerivedData, all fields recalculated")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&](int i) {
+            const std::vector<ExternalData>& exter = forcing[i % 2];
+            for (size_t c = 0; c < columns.size(); ++c) {
+                columns[c].updateDerivedData(columns[c], exter[c], columns[c]);
+            }
+            return columns.front().airDensity();
+        });
+    };
+
+    BENCHMARK("updateDerivedData, unchanged inputs")
+    {
+        for (auto& data : columns) {
+            data.updateDerivedData(data, data, data);
+        }
+        return columns.front().airDensity();
+    };
+}
+
+TEST_CASE("Specific humidity", "[NextsimPhysics]")
+{
+    const std::vector<ElementData> columns = ColumnStates::generate();
+    const NextsimPhysics::SpecificHumidity water;
+    const NextsimPhysics::SpecificHumidityIce ice;
+
+    BENCHMARK("SpecificHumidity, air")
+    {
+        double sum = 0;
+        for (auto& data : columns) {
+            sum += water(data.dewPoint2m(), data.airPressure());
+        }
+        return sum;
+    };
+
+    BENCHMARK("SpecificHumidity, sea water")
+    {
+        double sum = 0;
+        for (auto& data : columns) {
+            sum += water(data.seaSurfaceTemperature(), data.airPressure(),
+                data.seaSurfaceSalinity());
+        }
+        return sum;
+    };
+
+    BENCHMARK("SpecificHumidityIce")
+    {
+        double sum = 0;
+        for (auto& data : columns) {
+            sum += ice(data.iceTemperature(0), data.airPressure());
+        }
+        return sum;
+    };
+
+    BENCHMARK("SpecificHumidityIce::dq_dT")
+    {
+        double sum = 0;
+        for (auto& data : columns) {
+            sum += ice.dq_dT(data.iceTemperature(0), data.airPressure());
+        }
+        return sum;
+    };
+}
+
+} /* namespace Nextsim */
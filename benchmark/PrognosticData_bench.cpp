@@ -0,0 +1,30 @@
+/*!
+ * @file PrognosticData_bench.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+#include "include/PrognosticData.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Prognostic data integration", "[PrognosticData]")
+{
+    // The updated values of the one calculation of the physics are integrated on every run
+    std::vector<ElementData> columns = ColumnStates::generate();
+
+    BENCHMARK("PrognosticData::updateAndIntegrate")
+    {
+        for (auto& data : columns) {
+            data.updateAndIntegrate(data);
+        }
+        return columns.front().iceThickness();
+    };
+}
+
+} /* namespace Nextsim */
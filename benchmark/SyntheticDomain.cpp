@@ -0,0 +1,141 @@
+/*!
+ * @file SyntheticDomain.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "SyntheticDomain.hpp"
+
+#include "include/PrognosticGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace Nextsim {
+
+static const double pi = 3.14159265358979323846;
+// The centre and radius of the pack ice, and the width of the marginal ice zone
+static const double iceCentreX = 0.45;
+static const double iceCentreY = 0.55;
+static const double iceRadius = 0.3;
+static const double mizWidth = 0.08;
+static const double oceanFreezing = -1.8;
+
+static double clamp(double value, double low, double high)
+{
+    return std::min(std::max(value, low), high);
+}
+
+SyntheticDomain::SyntheticDomain(int nx, int ny, int nLayers, unsigned seed)
+    : m_nx(nx)
+    , m_ny(ny)
+    , m_nLayers(nLayers)
+    , m_lattice(latticeSize * latticeSize)
+{
+    if (nx <= 0 || ny <= 0 || nLayers <= 0)
+        throw std::invalid_argument("SyntheticDomain: the domain must have at least one element");
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (auto& node : m_lattice) {
+        node = uniform(gen);
+    }
+}
+
+double SyntheticDomain::noise(double x, double y) const
+{
+    // Bilinear interpolation of the lattice values
+    const double lx = x * (latticeSize - 1);
+    const double ly = y * (latticeSize - 1);
+    const int i = std::min(static_cast<int>(lx), latticeSize - 2);
+    const int j = std::min(static_cast<int>(ly), latticeSize - 2);
+    const double fx = lx - i;
+    const double fy = ly - j;
+    const double* row0 = &m_lattice[i * latticeSize + j];
+    const double* row1 = row0 + latticeSize;
+    return (1 - fx) * ((1 - fy) * row0[0] + fy * row0[1]) + fx * ((1 - fy) * row1[0] + fy * row1[1]);
+}
+
+double SyntheticDomain::iceDepth(double x, double y) const
+{
+    const double radius = std::hypot(x - iceCentreX, y - iceCentreY);
+    const double edge = iceRadius + 0.15 * (noise(x, y) - 0.5)
+        + 0.03 * std::sin(6 * pi * x) * std::cos(4 * pi * y);
+    return (edge - radius) / mizWidth;
+}
+
+void SyntheticDomain::set(int i, int j, ElementData& data) const
+{
+    const double x = (i + 0.5) / m_nx;
+    const double y = (j + 0.5) / m_ny;
+    const double depth = iceDepth(x, y);
+    const double local = noise(y, x);
+
+    // Concentration rises across the marginal ice zone, thickness and snow
+    // depth over the following three widths
+    const double cice = (depth <= 0) ? 0 : std::min(0.9 * depth, 0.95 + 0.05 * local);
+    const double packFraction = clamp(depth / 3, 0, 1);
+    const double hTrue = 0.2 + 2.8 * packFraction * (0.8 + 0.4 * local);
+    const double hSnowTrue = 0.02 + 0.3 * packFraction;
+
+    const double tair = 2 - 27 * clamp((depth + 2) / 5, 0, 1) + 3 * (local - 0.5);
+    const double sst = (cice > 0) ? oceanFreezing : oceanFreezing + 4 * clamp(-depth / 4, 0, 1);
+    // The ice is warmer than the air, and does not melt. The temperature
+    // rises linearly to freezing at the base of the ice.
+    const double tsurf = (cice > 0) ? std::min(tair + 3, 0.) : oceanFreezing;
+    std::vector<double> tice(m_nLayers);
+    for (int l = 0; l < m_nLayers; ++l) {
+        tice[l] = tsurf + (oceanFreezing - tsurf) * l / m_nLayers;
+    }
+
+    data = PrognosticGenerator(m_nLayers)
+               .hice(cice * hTrue)
+               .cice(cice)
+               .hsnow(cice * hSnowTrue)
+               .sst(sst)
+               .sss(33 + 1.5 * (y - 0.5))
+               .tice(tice);
+
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tair - 1 - 2 * local);
+    data.setAirPressure(101000 + 1500 * std::sin(2 * pi * x) * std::cos(2 * pi * y));
+    data.setMixingRatio(-1);
+    data.setIncomingShortwave(std::max(0., 250 * std::cos(pi * (y - 0.3))));
+    data.setIncomingLongwave(240 + 3 * tair);
+    data.setMixedLayerDepth(20 + 30 * x);
+    data.setSnowfall((local > 0.6) ? 2e-5 * (local - 0.6) / 0.4 : 0);
+    data.windSpeed() = 3 + 9 * noise(1 - x, y);
+}
+
+void SyntheticDomain::fill(IStructure& structure) const
+{
+    int index = 0;
+    for (structure.cursor = 0; structure.cursor; ++structure.cursor) {
+        if (index >= m_nx * m_ny)
+            throw std::length_error("SyntheticDomain::fill: the structure is too large");
+        set(index / m_ny, index % m_ny, *structure.cursor);
+        ++index;
+    }
+}
+
+void SyntheticDomain::fill(std::vector<ElementData>& data) const
+{
+    data.resize(m_nx * m_ny);
+    for (int index = 0; index < m_nx * m_ny; ++index) {
+        set(index / m_ny, index % m_ny, data[index]);
+    }
+}
+
+double SyntheticDomain::iceCoveredFraction() const
+{
+    int covered = 0;
+    for (int i = 0; i < m_nx; ++i) {
+        for (int j = 0; j < m_ny; ++j) {
+            covered += (iceDepth((i + 0.5) / m_nx, (j + 0.5) / m_ny) > 0) ? 1 : 0;
+        }
+    }
+    return static_cast<double>(covered) / (m_nx * m_ny);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,83 @@
+/*!
+ * @file SyntheticDomain.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef BENCHMARK_SYNTHETICDOMAIN_HPP
+#define BENCHMARK_SYNTHETICDOMAIN_HPP
+
+#include "include/ElementData.hpp"
+#include "include/IStructure.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class generating spatially varying states of a rectangular domain.
+ *
+ * @details The domain holds a core of pack ice, surrounded by a marginal ice
+ * zone and then open water. The ice edge is distorted by smooth random
+ * noise, so that the ice and open water fractions vary across the domain as
+ * they would in a regional model. The forcing follows the ice cover, with
+ * colder and drier air over the pack ice. The fields depend only on the
+ * position within the domain and the seed, so that domains of different
+ * sizes hold the same large scale pattern.
+ */
+class SyntheticDomain {
+public:
+    /*!
+     * @brief Creates a domain.
+     *
+     * @param nx The number of elements in the x direction.
+     * @param ny The number of elements in the y direction.
+     * @param nLayers The number of ice layers of each element.
+     * @param seed The seed of the noise distorting the ice edge.
+     */
+    SyntheticDomain(int nx, int ny, int nLayers = 1, unsigned seed = 1);
+
+    /*!
+     * @brief Sets the prognostic data and forcing of one element.
+     *
+     * @param i The x index of the element.
+     * @param j The y index of the element.
+     * @param data The element to be set.
+     */
+    void set(int i, int j, ElementData& data) const;
+
+    /*!
+     * @brief Sets all the elements of a structure, with the y index varying
+     * fastest.
+     *
+     * @param structure The structure, which must hold nx × ny elements.
+     */
+    void fill(IStructure& structure) const;
+    /*!
+     * @brief Sets all the elements of a vector, with the y index varying fastest.
+     *
+     * @param data The elements, which are resized to nx × ny.
+     */
+    void fill(std::vector<ElementData>& data) const;
+
+    //! Returns the fraction of the elements which hold any ice.
+    double iceCoveredFraction() const;
+
+private:
+    // Smooth noise in [0, 1) at a position in the unit square
+    double noise(double x, double y) const;
+    // The distance inside the ice edge in units of the width of the marginal
+    // ice zone, negative over open water
+    double iceDepth(double x, double y) const;
+
+    int m_nx;
+    int m_ny;
+    int m_nLayers;
+    // The values of the noise at the nodes of a coarse lattice
+    static const int latticeSize = 9;
+    std::vector<double> m_lattice;
+};
+
+} /* namespace Nextsim */
+
+#endif /* BENCHMARK_SYNTHETICDOMAIN_HPP */
@@ -0,0 +1,38 @@
+/*!
+ * @file ThermoIce0_bench.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+#include "include/NextsimPhysics.hpp"
+#include "include/ThermoIce0.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("ThermoIce0 thermodynamics", "[ThermoIce0]")
+{
+    std::vector<ElementData> columns = ColumnStates::generate();
+    // The fluxes calculated by the column physics, on which the thermodynamics depend
+    std::vector<NextsimPhysics> fluxes(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        fluxes[c].calculate(columns[c], columns[c], columns[c]);
+    }
+
+    ThermoIce0 thermo;
+    thermo.configure();
+
+    BENCHMARK("ThermoIce0::calculate")
+    {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            thermo.calculate(columns[c], columns[c], columns[c], fluxes[c]);
+        }
+        return columns.front().updatedIceTrueThickness();
+    };
+}
+
+} /* namespace Nextsim */
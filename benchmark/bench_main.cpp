@@ -0,0 +1,86 @@
+/*!
+ * @file bench_main.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "ColumnStates.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A Catch2 reporter writing the benchmark results as one JSON document.
+ *
+ * @details Selected with "-r json". The times are in nanoseconds, and the
+ * mean time per column is that of one run over ColumnStates::nColumns
+ * columns.
+ */
+class JsonReporter : public Catch::StreamingReporterBase<JsonReporter> {
+public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    static std::string getDescription() { return "Reports benchmark results as JSON"; }
+
+    void assertionStarting(const Catch::AssertionInfo&) override { }
+    bool assertionEnded(const Catch::AssertionStats&) override { return true; }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+    {
+        std::stringstream entry;
+        entry << "{\"name\": \"" << escape(stats.info.name) << "\", \"test_case\": \""
+              << escape(currentTestCaseInfo->name) << "\", \"samples\": " << stats.info.samples
+              << ", \"iterations\": " << stats.info.iterations
+              << ", \"mean_ns\": " << stats.mean.point.count()
+              << ", \"mean_lower_ns\": " << stats.mean.lower_bound.count()
+              << ", \"mean_upper_ns\": " << stats.mean.upper_bound.count()
+              << ", \"confidence_interval\": " << stats.mean.confidence_interval
+              << ", \"std_dev_ns\": " << stats.standardDeviation.point.count()
+              << ", \"outlier_variance\": " << stats.outlierVariance
+              << ", \"ns_per_column\": " << stats.mean.point.count() / ColumnStates::nColumns
+              << "}";
+        m_entries.push_back(entry.str());
+    }
+
+    void testRunEnded(const Catch::TestRunStats& stats) override
+    {
+        stream << "{\"context\": {\"columns\": " << ColumnStates::nColumns
+               << ", \"mixed_precision\": " <<
+#ifdef NEXTSIM_MIXED_PRECISION
+            "true"
+#else
+            "false"
+#endif
+               << "}," << std::endl
+               << "\"benchmarks\": [";
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            stream << (i > 0 ? "," : "") << std::endl << m_entries[i];
+        }
+        stream << std::endl << "]}" << std::endl;
+        StreamingReporterBase::testRunEnded(stats);
+    }
+
+private:
+    static std::string escape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::vector<std::string> m_entries;
+};
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
+
+} /* namespace Nextsim */
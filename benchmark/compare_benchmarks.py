@@ -0,0 +1,279 @@
+"""Compares benchmark results with the stored baseline of a machine profile.
+
+The results are read from the JSON written by nextsim_bench ("-r json") and
+nextsim_scaling ("--format json"), either from files or by running the
+executables themselves. Each benchmark is reduced to a time, in nanoseconds
+per call for the microbenchmarks and nanoseconds per column step for the
+scaling runs, and each run of the executables adds one sample of that time.
+
+A benchmark has regressed when the lower bound of the confidence interval of
+its relative slowdown exceeds the threshold. The interval is Welch's t
+interval of the difference between the mean times of the current and the
+baseline runs, so at least two runs are needed on each side. Noisy
+benchmarks then widen their own interval rather than raising false alarms.
+
+The baselines are stored one file per machine profile in
+benchmark/baselines/<profile>.json, and are written with --record.
+
+Exits with 0 if there are no regressions, 1 if there are, and 2 if the
+comparison could not be made.
+
+Examples:
+    compare_benchmarks.py --profile mylaptop --bench build/benchmark/nextsim_bench --record
+    compare_benchmarks.py --profile mylaptop run1.json run2.json run3.json
+"""
+
+import argparse
+import datetime
+import json
+import math
+import os
+import shlex
+import socket
+import subprocess
+import sys
+import tempfile
+
+BASELINE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "baselines")
+
+
+def microbenchmark_times(results):
+    """Returns the mean time of each benchmark of a nextsim_bench JSON report."""
+    return {f"{bench['test_case']}/{bench['name']}": bench["mean_ns"]
+            for bench in results["benchmarks"]}
+
+
+def scaling_times(results):
+    """Returns the time per column step of each run of a nextsim_scaling JSON report."""
+    times = {}
+    for run in results["runs"]:
+        name = f"scaling/{run['mode']}/{run['nx']}x{run['ny']}/{run['threads']} threads"
+        times[name] = 1e9 * run["wall_s"] / (run["columns"] * run["steps"])
+    return times
+
+
+def read_times(file_name):
+    """Reads the benchmark times and the context of a JSON report of either executable."""
+    with open(file_name) as results_file:
+        results = json.load(results_file)
+    if "benchmarks" in results:
+        return microbenchmark_times(results), results.get("context", {})
+    if "runs" in results:
+        return scaling_times(results), results.get("context", {})
+    raise ValueError(f"{file_name} is not a nextsim_bench or nextsim_scaling report")
+
+
+def run_executable(command, repeats, json_to_stdout):
+    """Runs a benchmark executable repeatedly, returning the times and the context of each run."""
+    runs = []
+    for repeat in range(repeats):
+        print(f"Run {repeat + 1} of {repeats}: {' '.join(command)}", file=sys.stderr)
+        if json_to_stdout:
+            output = subprocess.run(command, check=True, stdout=subprocess.PIPE).stdout
+            with tempfile.NamedTemporaryFile("wb", suffix=".json", delete=False) as out_file:
+                out_file.write(output)
+            file_name = out_file.name
+        else:
+            with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as out_file:
+                file_name = out_file.name
+            subprocess.run(command + ["-r", "json", "-o", file_name], check=True,
+                           stdout=subprocess.DEVNULL)
+        try:
+            runs.append(read_times(file_name))
+        finally:
+            os.remove(file_name)
+    return runs
+
+
+def merge_runs(runs):
+    """Combines the times of several runs into a list of samples per benchmark."""
+    samples = {}
+    context = {}
+    for times, run_context in runs:
+        context.update(run_context)
+        for name, time in times.items():
+            samples.setdefault(name, []).append(time)
+    return samples, context
+
+
+def incomplete_beta(a, b, x):
+    """Returns the regularized incomplete beta function I_x(a, b)."""
+    if x <= 0:
+        return 0.0
+    if x >= 1:
+        return 1.0
+    if x > (a + 1) / (a + b + 2):
+        # The continued fraction converges quickly only below the mean
+        return 1 - incomplete_beta(b, a, 1 - x)
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+                     + a * math.log(x) + b * math.log(1 - x)) / a
+    # Lentz's method for the continued fraction
+    tiny = 1e-300
+    f = 1.0
+    c = 1.0
+    d = 0.0
+    for i in range(400):
+        m = i // 2
+        if i == 0:
+            numerator = 1.0
+        elif i % 2 == 0:
+            numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+        else:
+            numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))
+        d = 1 + numerator * d
+        d = 1 / (d if abs(d) > tiny else tiny)
+        c = 1 + numerator / c
+        c = c if abs(c) > tiny else tiny
+        f *= c * d
+        if abs(1 - c * d) < 1e-12:
+            break
+    return front * (f - 1)
+
+
+def student_t_quantile(probability, dof):
+    """Returns the quantile of Student's t distribution for a probability above one half."""
+    def cdf(t):
+        return 1 - 0.5 * incomplete_beta(dof / 2, 0.5, dof / (dof + t * t))
+    low = 0.0
+    high = 1e3
+    for _ in range(100):
+        mid = (low + high) / 2
+        if cdf(mid) < probability:
+            low = mid
+        else:
+            high = mid
+    return (low + high) / 2
+
+
+def mean_and_variance(samples):
+    """Returns the mean and the unbiased variance of the samples."""
+    mean = sum(samples) / len(samples)
+    variance = sum((s - mean) ** 2 for s in samples) / (len(samples) - 1)
+    return mean, variance
+
+
+def slowdown_interval(baseline, current, confidence):
+    """Returns the relative slowdown of the current samples and its confidence interval.
+
+    The interval is Welch's t interval of the difference of the means,
+    relative to the baseline mean.
+    """
+    base_mean, base_var = mean_and_variance(baseline)
+    mean, var = mean_and_variance(current)
+    base_se2 = base_var / len(baseline)
+    se2 = var / len(current)
+    slowdown = (mean - base_mean) / base_mean
+    if base_se2 + se2 == 0:
+        return slowdown, slowdown, slowdown
+    # The Welch-Satterthwaite degrees of freedom
+    dof = (base_se2 + se2) ** 2 / (base_se2 ** 2 / (len(baseline) - 1)
+                                   + se2 ** 2 / (len(current) - 1))
+    half_width = student_t_quantile(0.5 + confidence / 2, dof) * math.sqrt(base_se2 + se2)
+    return slowdown, slowdown - half_width / base_mean, slowdown + half_width / base_mean
+
+
+def compare(baseline, samples, threshold, confidence):
+    """Prints the comparison of each benchmark, returning the names of those that regressed."""
+    regressions = []
+    print(f"{'benchmark':60} {'baseline':>12} {'current':>12} {'change':>8} "
+          f"{int(round(100 * confidence))}% interval")
+    for name in sorted(samples):
+        current = samples[name]
+        if name not in baseline:
+            print(f"{name:60} {'':>12} {sum(current) / len(current):12.1f}   (new, no baseline)")
+            continue
+        slowdown, lower, upper = slowdown_interval(baseline[name], current, confidence)
+        status = ""
+        if lower > threshold:
+            status = "  REGRESSION"
+            regressions.append(name)
+        elif upper < -threshold:
+            status = "  improvement"
+        print(f"{name:60} {sum(baseline[name]) / len(baseline[name]):12.1f} "
+              f"{sum(current) / len(current):12.1f} {100 * slowdown:+7.1f}% "
+              f"[{100 * lower:+.1f}%, {100 * upper:+.1f}%]{status}")
+    for name in sorted(set(baseline) - set(samples)):
+        print(f"{name:60}   (in the baseline, not run)")
+    return regressions
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(
+        description="Compare nextsim_bench and nextsim_scaling results with a stored baseline.")
+    parser.add_argument("results", nargs="*",
+                        help="JSON reports of nextsim_bench or nextsim_scaling, one per run")
+    parser.add_argument("--profile", default=socket.gethostname(),
+                        help="machine profile naming the baseline (default: the host name)")
+    parser.add_argument("--baseline-dir", default=BASELINE_DIR,
+                        help="directory of the baseline files")
+    parser.add_argument("--bench", help="nextsim_bench executable to run")
+    parser.add_argument("--bench-args", default="",
+                        help="further arguments of nextsim_bench, such as a test case filter")
+    parser.add_argument("--scaling", help="nextsim_scaling executable to run")
+    parser.add_argument("--scaling-args", default="--sizes 64,128 --steps 3",
+                        help="further arguments of nextsim_scaling")
+    parser.add_argument("--repeats", type=int, default=5,
+                        help="number of runs of each executable (default: 5)")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent above which a regression fails (default: 5)")
+    parser.add_argument("--confidence", type=float, default=0.95,
+                        help="confidence level of the intervals (default: 0.95)")
+    parser.add_argument("--record", action="store_true",
+                        help="store the results as the baseline of the profile")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_arguments()
+    if not 0 < args.confidence < 1:
+        print("The confidence level must lie between 0 and 1", file=sys.stderr)
+        return 2
+
+    runs = [read_times(file_name) for file_name in args.results]
+    if args.bench:
+        runs += run_executable([args.bench] + shlex.split(args.bench_args), args.repeats, False)
+    if args.scaling:
+        command = [args.scaling] + shlex.split(args.scaling_args) + ["--format", "json"]
+        runs += run_executable(command, args.repeats, True)
+    if not runs:
+        print("No results: give JSON reports, --bench or --scaling", file=sys.stderr)
+        return 2
+    samples, context = merge_runs(runs)
+
+    baseline_file = os.path.join(args.baseline_dir, f"{args.profile}.json")
+    if args.record:
+        os.makedirs(args.baseline_dir, exist_ok=True)
+        with open(baseline_file, "w") as out_file:
+            json.dump({"profile": args.profile,
+                       "recorded": datetime.datetime.now().isoformat(timespec="seconds"),
+                       "context": context,
+                       "benchmarks": samples}, out_file, indent=1, sort_keys=True)
+        print(f"Recorded {len(samples)} benchmarks as the baseline {baseline_file}")
+        return 0
+
+    if not os.path.exists(baseline_file):
+        print(f"No baseline for the profile {args.profile}: record one with --record",
+              file=sys.stderr)
+        return 2
+    with open(baseline_file) as in_file:
+        baseline = json.load(in_file)
+    if baseline["context"] != context:
+        print(f"Warning: the baseline was recorded with {baseline['context']}, "
+              f"these results with {context}", file=sys.stderr)
+    too_few = [name for name, times in samples.items()
+               if len(times) < 2 or len(baseline["benchmarks"].get(name, [0, 0])) < 2]
+    if too_few:
+        print(f"At least two runs of the baseline and of the results are needed to compare "
+              f"{', '.join(too_few)}", file=sys.stderr)
+        return 2
+
+    regressions = compare(baseline["benchmarks"], samples, args.threshold / 100, args.confidence)
+    if regressions:
+        print(f"{len(regressions)} benchmarks are more than {args.threshold}% slower than the "
+              f"baseline {args.profile}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,179 @@
+/*!
+ * @file golden.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Steps the column physics of a SyntheticDomain, a scaled up version of the
+ * run/dev1 configuration, and writes the final state as a DevGrid restart
+ * file. The reference path steps a DevGrid with DevStep::iterate(), exactly
+ * as the model does. The threaded path steps the same columns in contiguous
+ * blocks on several threads. Comparing the restart files of the two paths, or
+ * of builds with different options, with restart_diff shows any numerical
+ * drift of the optimised code. Both paths step the columns with
+ * DevStep::stepColumns() and stop at the first step that fails the health
+ * check.
+ *
+ * Usage: nextsim_golden output.nc [--path reference|threaded] [--threads 4]
+ *                       [--size 256] [--steps 24] [--layers 1] [--seed 1]
+ */
+
+#include "ColumnStates.hpp"
+#include "SyntheticDomain.hpp"
+#include "include/DevGrid.hpp"
+#include "include/DevGridIO.hpp"
+#include "include/DevStep.hpp"
+#include "include/ElementData.hpp"
+#include "include/PrognosticData.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Settings {
+    std::string fileName;
+    bool threaded = false;
+    int threads = 4;
+    int size = 256;
+    int steps = 24;
+    int layers = 1;
+    unsigned seed = 1;
+};
+
+Settings parseArguments(int argc, char* argv[])
+{
+    if (argc < 2)
+        throw std::invalid_argument("No output file given");
+    Settings settings;
+    settings.fileName = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 == argc)
+            throw std::invalid_argument("No value given for " + option);
+        const std::string value = argv[++i];
+        if (option == "--path") {
+            if (value != "reference" && value != "threaded")
+                throw std::invalid_argument("The path must be reference or threaded");
+            settings.threaded = (value == "threaded");
+        } else if (option == "--threads") {
+            settings.threads = std::stoi(value);
+        } else if (option == "--size") {
+            settings.size = std::stoi(value);
+        } else if (option == "--steps") {
+            settings.steps = std::stoi(value);
+        } else if (option == "--layers") {
+            settings.layers = std::stoi(value);
+        } else if (option == "--seed") {
+            settings.seed = std::stoul(value);
+        } else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+    if (settings.threads <= 0 || settings.steps <= 0)
+        throw std::invalid_argument("At least one thread and one step are needed");
+    return settings;
+}
+
+// The time step of the run/dev1 configuration is one hour
+const int timestep = 3600;
+
+void stepReference(Nextsim::DevGrid& grid, const Settings& settings)
+{
+    Nextsim::DevStep step;
+    step.setInitialData(grid);
+    step.setHealthCheck(Nextsim::HealthCheck::defaultMaxColumns);
+    for (int s = 0; s < settings.steps; ++s) {
+        step.iterate(timestep);
+    }
+}
+
+void stepThreaded(Nextsim::DevGrid& grid, const Nextsim::SyntheticDomain& domain,
+    const Settings& settings)
+{
+    std::vector<Nextsim::ElementData> columns;
+    domain.fill(columns);
+    Nextsim::PrognosticData::setTimestep(timestep);
+
+    // The columns are independent, so each thread steps its block to the end,
+    // or to the first step that fails the health check
+    std::vector<Nextsim::HealthCheck> checks(settings.threads);
+    std::vector<int> failedSteps(settings.threads, 0);
+    auto worker = [&](int thread) {
+        const size_t begin = columns.size() * thread / settings.threads;
+        const size_t end = columns.size() * (thread + 1) / settings.threads;
+        for (int s = 0; s < settings.steps; ++s) {
+            Nextsim::DevStep::stepColumns(
+                columns.data() + begin, columns.data() + end, &checks[thread], begin);
+            if (checks[thread].failed()) {
+                failedSteps[thread] = s + 1;
+                return;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < settings.threads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::stringstream message;
+    for (int t = 0; t < settings.threads; ++t) {
+        if (checks[t].failed()) {
+            message << "thread " << t << ": step " << failedSteps[t] << ": ";
+            checks[t].report(message);
+        }
+    }
+    if (!message.str().empty())
+        throw std::runtime_error(message.str());
+
+    size_t index = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor = columns[index++];
+    }
+}
+
+} /* anonymous namespace */
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    try {
+        settings = parseArguments(argc, argv);
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << "Usage: " << argv[0]
+                  << " output.nc [--path reference|threaded] [--threads 4] [--size 256]"
+                     " [--steps 24] [--layers 1] [--seed 1]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        Nextsim::ColumnStates::configureModules();
+        Nextsim::SyntheticDomain domain(settings.size, settings.size, settings.layers, settings.seed);
+        Nextsim::DevGrid grid;
+        grid.resize(settings.size, settings.size);
+        grid.init("");
+        grid.setIO(new Nextsim::DevGridIO(grid));
+        domain.fill(grid);
+
+        if (settings.threaded) {
+            stepThreaded(grid, domain, settings);
+        } else {
+            stepReference(grid, settings);
+        }
+        grid.dump(settings.fileName);
+    } catch (std::exception& e) {
+        // Including a failed health check, after which no file is written
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
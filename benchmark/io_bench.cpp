@@ -0,0 +1,242 @@
+/*!
+ * @file io_bench.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Measures the reading and writing of DevGrid restart files. For each grid
+ * size, number of ice layers, compression level and chunk size, the restart
+ * file of a SyntheticDomain is written with DevGridIO::dump, its structure is
+ * identified with StructureFactory::generateFromFile and it is read with
+ * DevGridIO::init. The file is evicted from the page cache before it is read,
+ * where the system allows.
+ *
+ * The results are written to standard output as CSV. Each operation has a
+ * line for its total time and one for each part timed by DevGridIO: the
+ * metadata, each variable, the unpacking into the elements and the closing of
+ * the file. The rates are of the uncompressed data, and the fraction is that
+ * of the total time of the operation.
+ *
+ * Usage: nextsim_io_bench [--sizes 64,256,1024] [--layers 1,3] [--deflate 0,1,4]
+ *                         [--chunks 0,64] [--repeats 3] [--dir .]
+ */
+
+#include "ColumnStates.hpp"
+#include "SyntheticDomain.hpp"
+#include "include/DevGrid.hpp"
+#include "include/DevGridIO.hpp"
+#include "include/ScopedTimer.hpp"
+#include "include/StructureFactory.hpp"
+#include "include/Timer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Nextsim::ScopedTimer;
+using Nextsim::Timer;
+
+struct Settings {
+    std::vector<int> sizes = { 64, 256, 1024 };
+    std::vector<int> layers = { 1, 3 };
+    std::vector<int> deflateLevels = { 0, 1, 4 };
+    std::vector<int> chunks = { 0, 64 };
+    int repeats = 3;
+    std::string directory = ".";
+};
+
+std::vector<int> parseList(const std::string& list)
+{
+    std::vector<int> values;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::stoi(item));
+        if (values.back() < 0)
+            throw std::invalid_argument("No value may be negative");
+    }
+    if (values.empty())
+        throw std::invalid_argument("Empty list of values");
+    return values;
+}
+
+Settings parseArguments(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 == argc)
+            throw std::invalid_argument("No value given for " + option);
+        const std::string value = argv[++i];
+        if (option == "--sizes") {
+            settings.sizes = parseList(value);
+        } else if (option == "--layers") {
+            settings.layers = parseList(value);
+        } else if (option == "--deflate") {
+            settings.deflateLevels = parseList(value);
+        } else if (option == "--chunks") {
+            settings.chunks = parseList(value);
+        } else if (option == "--repeats") {
+            settings.repeats = std::stoi(value);
+        } else if (option == "--dir") {
+            settings.directory = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+    if (settings.repeats <= 0)
+        throw std::invalid_argument("At least one repeat is needed");
+    return settings;
+}
+
+// Writes any cached data of a file to disk and evicts it from the page cache
+void evict(const std::string& fileName)
+{
+#ifdef POSIX_FADV_DONTNEED
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+double fileBytes(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    return static_cast<double>(file.tellg());
+}
+
+struct Case {
+    int n;
+    int layers;
+    int deflate;
+    int chunk;
+    double fileMB;
+    int repeats;
+};
+
+void writeLine(const Case& c, const std::string& operation, const std::string& part,
+    double seconds, double bytes, double totalSeconds)
+{
+    const double mb = bytes / (1 << 20);
+    std::cout << operation << "," << c.n << "," << c.n << "," << c.layers << "," << c.deflate
+              << "," << c.chunk << "," << c.fileMB << ",\"" << part << "\"," << seconds << ","
+              << mb << "," << ((mb > 0) ? mb / seconds : 0) << "," << seconds / totalSeconds
+              << std::endl;
+}
+
+/*
+ * Writes the total of the operation timed by the named root timer and each of
+ * its parts. The bytes of each variable are taken from the name of its timer.
+ */
+void writeParts(const Case& c, const std::string& operation, const Timer& timer,
+    const std::string& rootName)
+{
+    const double nElements = static_cast<double>(c.n) * c.n;
+    const double totalSeconds = timer.elapsed(rootName) / c.repeats;
+    const double totalBytes = nElements * (5 + c.layers) * sizeof(double);
+    writeLine(c, operation, "total", totalSeconds, totalBytes, totalSeconds);
+    for (const std::string& part : timer.children(rootName)) {
+        double bytes = 0;
+        if (part == "read tice" || part == "write tice") {
+            bytes = nElements * c.layers * sizeof(double);
+        } else if (part.compare(0, 5, "read ") == 0 || part.compare(0, 6, "write ") == 0) {
+            bytes = nElements * sizeof(double);
+        }
+        writeLine(c, operation, part, timer.elapsed(part) / c.repeats, bytes, totalSeconds);
+    }
+}
+
+void runCase(Case& c, const Settings& settings)
+{
+    Nextsim::SyntheticDomain domain(c.n, c.n, c.layers);
+    Nextsim::DevGrid grid;
+    grid.resize(c.n, c.n);
+    grid.init("");
+    Nextsim::DevGridIO* io = new Nextsim::DevGridIO(grid);
+    io->setCompression(c.deflate);
+    io->setChunking(c.chunk, c.chunk);
+    grid.setIO(io);
+    domain.fill(grid);
+
+    std::stringstream fileName;
+    fileName << settings.directory << "/io_bench_" << c.n << "_" << c.layers << "_" << c.deflate
+             << "_" << c.chunk << ".nc";
+
+    Timer dumpTimer;
+    Timer initTimer;
+    double generateSeconds = 0;
+    for (int r = 0; r < c.repeats; ++r) {
+        ScopedTimer::setTimerAddress(&dumpTimer);
+        grid.dump(fileName.str());
+
+        evict(fileName.str());
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<Nextsim::IStructure> structure
+            = Nextsim::StructureFactory::generateFromFile(fileName.str());
+        generateSeconds
+            += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        evict(fileName.str());
+        ScopedTimer::setTimerAddress(&initTimer);
+        structure->init(fileName.str());
+        ScopedTimer::setTimerAddress(nullptr);
+    }
+    c.fileMB = fileBytes(fileName.str()) / (1 << 20);
+    std::remove(fileName.str().c_str());
+
+    writeParts(c, "dump", dumpTimer, "DevGridIO::dump");
+    writeLine(c, "generateFromFile", "total", generateSeconds / c.repeats, 0,
+        generateSeconds / c.repeats);
+    writeParts(c, "init", initTimer, "DevGridIO::init");
+}
+
+} /* anonymous namespace */
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    try {
+        settings = parseArguments(argc, argv);
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << "Usage: " << argv[0]
+                  << " [--sizes 64,256,1024] [--layers 1,3] [--deflate 0,1,4] [--chunks 0,64]"
+                     " [--repeats 3] [--dir .]"
+                  << std::endl;
+        return 1;
+    }
+
+    Nextsim::ColumnStates::configureModules();
+
+    std::cout << "operation,nx,ny,layers,deflate,chunk,file_MB,part,seconds,MB,MB_per_s,fraction"
+              << std::endl;
+    try {
+        for (int n : settings.sizes) {
+            for (int layers : settings.layers) {
+                for (int deflate : settings.deflateLevels) {
+                    for (int chunk : settings.chunks) {
+                        Case c = { n, layers, deflate, chunk, 0, settings.repeats };
+                        runCase(c, settings);
+                    }
+                }
+            }
+        }
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*!
+ * @file make_devgrid_restart.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Writes a DevGrid restart file of any size, holding the spatially varying
+ * ice cover of a SyntheticDomain.
+ *
+ * Usage: make_devgrid_restart nx ny output.nc [nLayers] [seed]
+ */
+
+#include "ColumnStates.hpp"
+#include "SyntheticDomain.hpp"
+#include "include/DevGrid.hpp"
+#include "include/DevGridIO.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4 || argc > 6) {
+        std::cerr << "Usage: " << argv[0] << " nx ny output.nc [nLayers] [seed]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const int nx = std::stoi(argv[1]);
+        const int ny = std::stoi(argv[2]);
+        const std::string fileName = argv[3];
+        const int nLayers = (argc > 4) ? std::stoi(argv[4]) : 1;
+        const unsigned seed = (argc > 5) ? std::stoul(argv[5]) : 1;
+
+        Nextsim::ColumnStates::configureModules();
+        Nextsim::SyntheticDomain domain(nx, ny, nLayers, seed);
+        Nextsim::DevGrid grid;
+        grid.resize(nx, ny);
+        grid.init("");
+        grid.setIO(new Nextsim::DevGridIO(grid));
+        domain.fill(grid);
+        grid.dump(fileName);
+
+        std::cerr << "Wrote " << nx << " × " << ny << " elements to " << fileName << ", "
+                  << 100 * domain.iceCoveredFraction() << "% ice covered" << std::endl;
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*!
+ * @file scaling.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Measures the strong and weak scaling of the column physics over threads.
+ * Each run fills a SyntheticDomain and steps it with DevStep::stepColumns(),
+ * with the columns divided into one contiguous block per thread and the
+ * threads synchronized at the end of each time step. The strong scaling
+ * runs step each square domain with each number of threads. The weak scaling
+ * runs give each thread a domain of the first size. The results are written
+ * to standard output as CSV, one line per run, or as JSON.
+ *
+ * Usage: nextsim_scaling [--sizes 64,128,256] [--threads 1,2,4] [--steps 5]
+ *                        [--layers 1] [--seed 1] [--format csv|json]
+ */
+
+#include "ColumnStates.hpp"
+#include "SyntheticDomain.hpp"
+#include "include/DevStep.hpp"
+#include "include/ElementData.hpp"
+#include "include/PrognosticData.hpp"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A reusable barrier for a fixed number of threads
+class Barrier {
+public:
+    Barrier(int nThreads)
+        : m_nThreads(nThreads)
+        , m_waiting(0)
+        , m_generation(0)
+    {
+    }
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const long generation = m_generation;
+        if (++m_waiting == m_nThreads) {
+            m_waiting = 0;
+            ++m_generation;
+            m_released.notify_all();
+        } else {
+            m_released.wait(lock, [&]() { return m_generation != generation; });
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    const int m_nThreads;
+    int m_waiting;
+    long m_generation;
+};
+
+struct Settings {
+    std::vector<int> sizes = { 64, 128, 256 };
+    std::vector<int> threads;
+    int steps = 5;
+    int layers = 1;
+    unsigned seed = 1;
+    bool json = false;
+};
+
+std::vector<int> parseList(const std::string& list)
+{
+    std::vector<int> values;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::stoi(item));
+        if (values.back() <= 0)
+            throw std::invalid_argument("All sizes and thread counts must be positive");
+    }
+    return values;
+}
+
+Settings parseArguments(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 == argc)
+            throw std::invalid_argument("No value given for " + option);
+        const std::string value = argv[++i];
+        if (option == "--sizes") {
+            settings.sizes = parseList(value);
+        } else if (option == "--threads") {
+            settings.threads = parseList(value);
+        } else if (option == "--steps") {
+            settings.steps = std::stoi(value);
+        } else if (option == "--layers") {
+            settings.layers = std::stoi(value);
+        } else if (option == "--seed") {
+            settings.seed = std::stoul(value);
+        } else if (option == "--format") {
+            if (value != "csv" && value != "json")
+                throw std::invalid_argument("The format must be csv or json");
+            settings.json = (value == "json");
+        } else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+    if (settings.threads.empty()) {
+        // Powers of two up to the number of hardware threads
+        const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (int n = 1; n < maxThreads; n *= 2) {
+            settings.threads.push_back(n);
+        }
+        settings.threads.push_back(maxThreads);
+    }
+    if (settings.sizes.empty() || settings.steps <= 0)
+        throw std::invalid_argument("At least one size and one step are needed");
+    return settings;
+}
+
+// The heap memory in use, or zero where it cannot be measured
+double heapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<double>(info.uordblks + info.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+struct Run {
+    std::string mode;
+    int nx;
+    int ny;
+    int threads;
+    double seconds;
+    double bytesPerColumn;
+};
+
+// Steps the column physics of a new domain, returning the wall time and memory per column
+Run run(const std::string& mode, int nx, int ny, int nThreads, const Settings& settings)
+{
+    const double heapBefore = heapBytes();
+    std::vector<Nextsim::ElementData> columns;
+    Nextsim::SyntheticDomain(nx, ny, settings.layers, settings.seed).fill(columns);
+    const double heapAfter = heapBytes();
+
+    Barrier barrier(nThreads);
+    auto worker = [&](int thread) {
+        const size_t begin = columns.size() * thread / nThreads;
+        const size_t end = columns.size() * (thread + 1) / nThreads;
+        for (int step = 0; step < settings.steps; ++step) {
+            Nextsim::DevStep::stepColumns(columns.data() + begin, columns.data() + end);
+            barrier.wait();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double seconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return Run { mode, nx, ny, nThreads, seconds, (heapAfter - heapBefore) / columns.size() };
+}
+
+void writeHeader(const Settings& settings)
+{
+    if (settings.json) {
+        std::cout << "{\"context\": {\"layers\": " << settings.layers
+                  << ", \"seed\": " << settings.seed << ", \"mixed_precision\": " <<
+#ifdef NEXTSIM_MIXED_PRECISION
+            "true"
+#else
+            "false"
+#endif
+                  << "}," << std::endl
+                  << "\"runs\": [";
+    } else {
+        std::cout << "mode,nx,ny,columns,threads,steps,wall_s,columns_per_s,parallel_efficiency,"
+                     "bytes_per_column"
+                  << std::endl;
+    }
+}
+
+void writeRun(const Run& result, double efficiency, const Settings& settings, bool first)
+{
+    const double nColumns = static_cast<double>(result.nx) * result.ny;
+    if (settings.json) {
+        std::cout << (first ? "" : ",") << std::endl
+                  << "{\"mode\": \"" << result.mode << "\", \"nx\": " << result.nx
+                  << ", \"ny\": " << result.ny << ", \"columns\": " << static_cast<long>(nColumns)
+                  << ", \"threads\": " << result.threads << ", \"steps\": " << settings.steps
+                  << ", \"wall_s\": " << result.seconds
+                  << ", \"columns_per_s\": " << nColumns * settings.steps / result.seconds
+                  << ", \"parallel_efficiency\": " << efficiency
+                  << ", \"bytes_per_column\": " << result.bytesPerColumn << "}";
+    } else {
+        std::cout << result.mode << "," << result.nx << "," << result.ny << ","
+                  << static_cast<long>(nColumns) << "," << result.threads << "," << settings.steps
+                  << "," << result.seconds << "," << nColumns * settings.steps / result.seconds
+                  << "," << efficiency << "," << result.bytesPerColumn << std::endl;
+    }
+}
+
+} /* anonymous namespace */
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    try {
+        settings = parseArguments(argc, argv);
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << "Usage: " << argv[0]
+                  << " [--sizes 64,128,256] [--threads 1,2,4] [--steps 5] [--layers 1] [--seed 1]"
+                     " [--format csv|json]"
+                  << std::endl;
+        return 1;
+    }
+
+    Nextsim::ColumnStates::configureModules();
+    // One hour time steps
+    Nextsim::PrognosticData::setTimestep(3600);
+
+    writeHeader(settings);
+    bool first = true;
+
+    // Strong scaling: the same domain over more threads
+    for (int size : settings.sizes) {
+        double serialSeconds = 0;
+        for (int nThreads : settings.threads) {
+            Run result = run("strong", size, size, nThreads, settings);
+            if (nThreads == settings.threads.front())
+                serialSeconds = result.seconds * nThreads;
+            writeRun(result, serialSeconds / (result.seconds * nThreads), settings, first);
+            first = false;
+        }
+    }
+
+    // Weak scaling: one domain of the first size per thread
+    const int size = settings.sizes.front();
+    double baseSeconds = 0;
+    for (int nThreads : settings.threads) {
+        Run result = run("weak", size, size * nThreads, nThreads, settings);
+        if (nThreads == settings.threads.front())
+            baseSeconds = result.seconds;
+        writeRun(result, baseSeconds / result.seconds, settings, first);
+        first = false;
+    }
+    if (settings.json)
+        std::cout << std::endl << "]}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*!
+ * @file AllocationCounter.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Replaces the global operator new and delete with versions which count the
+ * allocations of each thread. Only link this file into executables which
+ * should count allocations.
+ */
+
+#include "include/AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace Nextsim {
+static const bool counterInstalled = AllocationCounter::install();
+
+static inline void* countedAllocation(std::size_t size)
+{
+    AllocationCounter::Counts& counts = AllocationCounter::threadCounts();
+    ++counts.allocations;
+    counts.bytes += size;
+    return std::malloc(size ? size : 1);
+}
+} /* namespace Nextsim */
+
+void* operator new(std::size_t size)
+{
+    void* ptr = Nextsim::countedAllocation(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* ptr = Nextsim::countedAllocation(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Nextsim::countedAllocation(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Nextsim::countedAllocation(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
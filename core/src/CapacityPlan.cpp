@@ -0,0 +1,283 @@
+/*!
+ * @file CapacityPlan.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/CapacityPlan.hpp"
+
+#include "include/ElementData.hpp"
+#include "include/IPhysics1d.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+template <>
+const std::map<int, std::string> Configured<CapacityPlan>::keyMap = {
+    { CapacityPlan::PROCESSES_KEY, "capacity.processes" },
+    { CapacityPlan::THREADS_KEY, "capacity.threads" },
+    { CapacityPlan::OUTPUTINTERVAL_KEY, "capacity.output_interval" },
+    { CapacityPlan::CHECKPOINTINTERVAL_KEY, "capacity.checkpoint_interval" },
+    { CapacityPlan::COLUMNCOSTS_KEY, "capacity.column_costs" },
+    { CapacityPlan::IORATES_KEY, "capacity.io_rates" },
+};
+
+static const double secondsPerDay = 86400;
+static const double bytesPerMB = 1 << 20;
+// The prognostic fields of a restart file, besides the ice temperatures
+static const int nRestartFields = 5;
+
+CapacityPlan::CapacityPlan()
+    : m_processes(1)
+    , m_threads(1)
+    , m_outputInterval(0)
+    , m_checkpointInterval(0)
+    , m_nx(0)
+    , m_ny(0)
+    , m_nLayers(1)
+    , m_nSteps(0)
+    , m_timestep(0)
+    , m_nsPerColumn(0)
+    , m_writeBytesPerSecond(0)
+    , m_readBytesPerSecond(0)
+{
+}
+
+void CapacityPlan::configure()
+{
+    m_processes = Configured::getConfiguration(keyMap.at(PROCESSES_KEY), 1);
+    m_threads = Configured::getConfiguration(keyMap.at(THREADS_KEY), 1);
+    m_outputInterval = Configured::getConfiguration(keyMap.at(OUTPUTINTERVAL_KEY), 0);
+    m_checkpointInterval = Configured::getConfiguration(keyMap.at(CHECKPOINTINTERVAL_KEY), 0);
+    if (m_processes <= 0 || m_threads <= 0)
+        throw std::domain_error("CapacityPlan: the processes and threads must be positive");
+    if (m_outputInterval < 0 || m_checkpointInterval < 0)
+        throw std::domain_error("CapacityPlan: the intervals must not be negative");
+
+    std::string columnCostsFile
+        = Configured::getConfiguration(keyMap.at(COLUMNCOSTS_KEY), std::string());
+    if (!columnCostsFile.empty()) {
+        std::ifstream is(columnCostsFile);
+        if (!is)
+            throw std::invalid_argument("CapacityPlan: could not open " + columnCostsFile);
+        readColumnCosts(is);
+    }
+    std::string ioRatesFile = Configured::getConfiguration(keyMap.at(IORATES_KEY), std::string());
+    if (!ioRatesFile.empty()) {
+        std::ifstream is(ioRatesFile);
+        if (!is)
+            throw std::invalid_argument("CapacityPlan: could not open " + ioRatesFile);
+        readIORates(is);
+    }
+}
+
+void CapacityPlan::setGrid(const std::string& structureName, int nx, int ny, int nLayers)
+{
+    m_structureName = structureName;
+    m_nx = nx;
+    m_ny = ny;
+    m_nLayers = nLayers;
+}
+
+void CapacityPlan::setRun(int nSteps, int timestep)
+{
+    m_nSteps = nSteps;
+    m_timestep = timestep;
+}
+
+void CapacityPlan::setModules(const std::map<std::string, std::string>& implementations)
+{
+    m_implementations = implementations;
+}
+
+typedef std::vector<std::map<std::string, std::string>> CSVRows;
+
+// Reads CSV with a header line into a map from the column names to the
+// values of each row, without any quotes around the values.
+static CSVRows readRows(std::istream& is)
+{
+    auto split = [](const std::string& line) {
+        std::vector<std::string> values;
+        std::stringstream ss(line);
+        std::string value;
+        while (std::getline(ss, value, ',')) {
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                value = value.substr(1, value.size() - 2);
+            values.push_back(value);
+        }
+        return values;
+    };
+    std::string line;
+    std::getline(is, line);
+    const std::vector<std::string> names = split(line);
+    CSVRows rows;
+    while (std::getline(is, line)) {
+        const std::vector<std::string> values = split(line);
+        if (values.size() != names.size())
+            continue;
+        rows.emplace_back();
+        for (size_t i = 0; i < names.size(); ++i) {
+            rows.back()[names[i]] = values[i];
+        }
+    }
+    return rows;
+}
+
+void CapacityPlan::readColumnCosts(std::istream& is)
+{
+    for (auto& row : readRows(is)) {
+        if (row["pass"] == "total" && !row["ns_per_column"].empty()) {
+            m_nsPerColumn = std::stod(row["ns_per_column"]);
+            return;
+        }
+    }
+    throw std::invalid_argument("CapacityPlan: no total cost per column in the column costs");
+}
+
+void CapacityPlan::readIORates(std::istream& is)
+{
+    double writeMB = 0;
+    double readMB = 0;
+    for (auto& row : readRows(is)) {
+        if (row["part"] != "total" || row["MB_per_s"].empty() || row["file_MB"].empty())
+            continue;
+        const double fileMB = std::stod(row["file_MB"]);
+        const double rate = std::stod(row["MB_per_s"]) * bytesPerMB;
+        if (row["operation"] == "dump" && fileMB >= writeMB) {
+            writeMB = fileMB;
+            m_writeBytesPerSecond = rate;
+        } else if (row["operation"] == "init" && fileMB >= readMB) {
+            readMB = fileMB;
+            m_readBytesPerSecond = rate;
+        }
+    }
+    if (m_writeBytesPerSecond <= 0 || m_readBytesPerSecond <= 0)
+        throw std::invalid_argument("CapacityPlan: no dump and init rates in the I/O rates");
+}
+
+size_t CapacityPlan::columnsPerProcess() const
+{
+    const size_t nColumns = static_cast<size_t>(m_nx) * m_ny;
+    return (nColumns + m_processes - 1) / m_processes;
+}
+
+// The bytes taken by a heap allocation, including the overhead of glibc malloc
+static double heapBytes(size_t size) { return std::max<size_t>(32, (size + 8 + 15) / 16 * 16); }
+
+double CapacityPlan::memoryPerProcess() const
+{
+    // Each element holds the ice temperatures of its prognostic and physics
+    // data and its physics implementation on the heap, and the timing
+    // decorator wrapping the implementation if the modules are timed.
+    const ModuleLoader& loader = ModuleLoader::getLoader();
+    const size_t physicsSize = loader.getInstanceSize<IPhysics1d>();
+    if (physicsSize == 0)
+        throw std::logic_error("CapacityPlan: no implementation of IPhysics1d has been set");
+    double columnBytes = sizeof(ElementData) + 2 * heapBytes(m_nLayers * sizeof(double))
+        + heapBytes(physicsSize);
+    const size_t decoratorSize = loader.getDecoratorSize<IPhysics1d>();
+    if (decoratorSize > 0)
+        columnBytes += heapBytes(decoratorSize);
+    // While a restart file is read, all of its fields are held at once besides
+    // the elements
+    return columnsPerProcess() * (columnBytes + (nRestartFields + m_nLayers) * sizeof(double));
+}
+
+double CapacityPlan::restartBytes() const
+{
+    return static_cast<double>(m_nx) * m_ny * (nRestartFields + m_nLayers) * sizeof(double);
+}
+
+double CapacityPlan::ioBytesPerDay() const
+{
+    if (m_timestep <= 0)
+        return 0;
+    const double stepsPerDay = secondsPerDay / m_timestep;
+    double filesPerDay = 0;
+    for (int interval : { m_outputInterval, m_checkpointInterval }) {
+        if (interval > 0)
+            filesPerDay += stepsPerDay / interval;
+    }
+    return filesPerDay * restartBytes();
+}
+
+int CapacityPlan::writesPerRun(int interval) const
+{
+    return (interval > 0) ? m_nSteps / interval : 0;
+}
+
+double CapacityPlan::bytesRead() const { return restartBytes(); }
+
+double CapacityPlan::bytesWritten() const
+{
+    // The outputs and checkpoints, and the final restart file
+    return (writesPerRun(m_outputInterval) + writesPerRun(m_checkpointInterval) + 1)
+        * restartBytes();
+}
+
+double CapacityPlan::computeSeconds() const
+{
+    // The cost per column is per thread, and the threads are assumed to scale perfectly
+    return 1e-9 * m_nsPerColumn * m_nSteps * columnsPerProcess() / m_threads;
+}
+
+double CapacityPlan::ioSeconds() const
+{
+    if (m_writeBytesPerSecond <= 0 || m_readBytesPerSecond <= 0)
+        return 0;
+    return bytesRead() / m_readBytesPerSecond + bytesWritten() / m_writeBytesPerSecond;
+}
+
+void CapacityPlan::report(std::ostream& os) const
+{
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "Capacity plan" << std::endl;
+    os << "  Grid: " << m_structureName << ", " << m_nx << " x " << m_ny << " elements, "
+       << m_nLayers << " ice layer" << ((m_nLayers == 1) ? "" : "s") << std::endl;
+    os << "  Modules:" << std::endl;
+    for (const auto& implementation : m_implementations) {
+        os << "    " << implementation.first << ": " << implementation.second << std::endl;
+    }
+    os << "  Run: " << m_nSteps << " time steps of " << m_timestep << " s, "
+       << m_nSteps * static_cast<double>(m_timestep) / secondsPerDay << " simulated days"
+       << std::endl;
+    os << "  Processes: " << m_processes << ", threads per process: " << m_threads
+       << ", columns per process: " << columnsPerProcess() << std::endl;
+    os << "  Memory per process: " << memoryPerProcess() / bytesPerMB
+       << " MB of model data, excluding the executable and libraries" << std::endl;
+    os << "  Restart file: " << restartBytes() / bytesPerMB << " MB uncompressed" << std::endl;
+    os << "  Output and checkpoints per simulated day: " << ioBytesPerDay() / bytesPerMB << " MB"
+       << std::endl;
+    os << "  I/O of the run: " << bytesRead() / bytesPerMB << " MB read, "
+       << bytesWritten() / bytesPerMB << " MB written" << std::endl;
+    if (m_nsPerColumn > 0) {
+        os << "  Column physics: " << computeSeconds() << " s at " << m_nsPerColumn
+           << " ns per column step and thread" << std::endl;
+    } else {
+        os << "  Column physics: not calibrated, set " << keyMap.at(COLUMNCOSTS_KEY)
+           << " to the output of nextsim_column_proxy" << std::endl;
+    }
+    if (m_writeBytesPerSecond > 0) {
+        os << "  I/O: " << ioSeconds() << " s at " << m_readBytesPerSecond / bytesPerMB
+           << " MB/s read and " << m_writeBytesPerSecond / bytesPerMB << " MB/s written"
+           << std::endl;
+    } else {
+        os << "  I/O: not calibrated, set " << keyMap.at(IORATES_KEY)
+           << " to the output of nextsim_io_bench" << std::endl;
+    }
+    if (m_nsPerColumn > 0 && m_writeBytesPerSecond > 0)
+        os << "  Estimated run time: " << computeSeconds() + ioSeconds() << " s" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} /* namespace Nextsim */
@@ -34,6 +34,8 @@ CommandLineParser::CommandLineParser(int argc, char* argv[])
             (manyConfigFiles,
                     boost::program_options::value<std::vector<std::string>>()->multitoken(),
                     "specify a list of configuration files" )
+            ("dry-run",
+                    "report the memory, I/O and run time of the configured run without running it")
              ;
     // clang-format on
     auto parsed = boost::program_options::command_line_parser(argc, argv)
@@ -65,4 +67,6 @@ CommandLineParser::CommandLineParser(int argc, char* argv[])
  */
 std::vector<std::string> CommandLineParser::getConfigFileNames() { return m_configFilenames; }
 
+bool CommandLineParser::isDryRun() const { return m_arguments.count("dry-run"); }
+
 } /* namespace Nextsim */
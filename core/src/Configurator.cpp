@@ -7,54 +7,128 @@
 
 #include "include/Configurator.hpp"
 
+#include <cctype>
 #include <iostream>
 
 namespace Nextsim {
 
-std::vector<std::unique_ptr<std::istream>> Configurator::sources;
-int Configurator::m_argc;
-char** Configurator::m_argv;
+Configurator::Store Configurator::commandLineValues;
+Configurator::Store Configurator::streamValues;
+std::set<std::string> Configurator::separateValues;
+std::map<std::string, boost::any> Configurator::typedValues;
+int Configurator::m_parseCount = 0;
+
+void Configurator::addStream(std::unique_ptr<std::istream> pis)
+{
+    ++m_parseCount;
+    // With no options described, every option in the stream is returned as
+    // unregistered, named by its section and key.
+    boost::program_options::options_description all;
+    try {
+        boost::program_options::parsed_options parsed
+            = boost::program_options::parse_config_file(*pis, all, true);
+        for (const auto& option : parsed.options) {
+            // An option set by an earlier stream keeps its value
+            streamValues.emplace(option.string_key, option.value);
+        }
+    } catch (std::exception& e) {
+        // Echo the exception, but carry on
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void Configurator::clearStreams()
+{
+    streamValues.clear();
+    typedValues.clear();
+}
+
+// Whether a command line argument is a value rather than an option
+static bool isValue(const char* arg)
+{
+    if (arg[0] != '-')
+        return true;
+    // Negative numbers such as -5, -.5 or -1e3
+    return std::isdigit(static_cast<unsigned char>(arg[1]))
+        || (arg[1] == '.' && std::isdigit(static_cast<unsigned char>(arg[2])));
+}
+
+void Configurator::setCommandLine(int argc, char* argv[])
+{
+    commandLineValues.clear();
+    separateValues.clear();
+    typedValues.clear();
+    if (!argv)
+        return;
+    ++m_parseCount;
+    for (int i = 1; i < argc; ++i) {
+        const std::string token = argv[i];
+        // Everything after "--" is positional
+        if (token == "--")
+            break;
+        if (token.compare(0, 2, "--") != 0)
+            continue;
+        std::string name = token.substr(2);
+        std::string value;
+        bool hasValue = false;
+        const size_t equals = name.find('=');
+        if (equals != std::string::npos) {
+            value = name.substr(equals + 1);
+            name.resize(equals);
+            hasValue = true;
+        } else if (i + 1 < argc && isValue(argv[i + 1])) {
+            value = argv[++i];
+            hasValue = true;
+            separateValues.insert(name);
+        }
+        // A repeated option adds its value to those of its earlier occurrences
+        std::vector<std::string>& values = commandLineValues[name];
+        if (hasValue)
+            values.push_back(value);
+    }
+}
+
+const std::vector<std::string>* Configurator::find(const std::string& name)
+{
+    Store::const_iterator found = commandLineValues.find(name);
+    if (found != commandLineValues.end())
+        return &found->second;
+    found = streamValues.find(name);
+    return (found != streamValues.end()) ? &found->second : nullptr;
+}
 
 boost::program_options::variables_map Configurator::parse(
     const boost::program_options::options_description& opt)
 {
     boost::program_options::variables_map vm;
 
-    // Parse the command file for any overrides
-    int use_argc;
-    char** use_argv;
-    if (m_argc && m_argv) {
-        use_argc = m_argc;
-        use_argv = m_argv;
-    } else {
-        // Use a fake command line to ensure at least one parse happens in all cases
-        use_argc = 1;
-        char name[] = { 'n', 'e', 'x', 't', 's', 'i', 'm', 'd', 'g', '\0' };
-        char* fake_argv[] = { name, nullptr };
-        use_argv = fake_argv;
-    }
-    auto parsed = boost::program_options::command_line_parser(use_argc, use_argv)
-                      .options(opt)
-                      .style(boost::program_options::command_line_style::
-                              unix_style) // | po::command_line_style::allow_long_disguise)
-                      .allow_unregistered()
-                      .run();
-    boost::program_options::store(parsed, vm);
-
-    // Parse the named streams for configuration
-    for (auto iter = sources.begin(); iter != sources.end(); ++iter) {
-        try {
-            boost::program_options::store(
-                boost::program_options::parse_config_file(**iter, opt, true), vm);
-        } catch (std::exception& e) {
-            // Echo the exception, but carry on
-            std::cerr << e.what() << std::endl;
+    for (const auto& description : opt.options()) {
+        const std::string& name = description->long_name();
+        const std::vector<std::string>* values = find(name);
+        if (!values)
+            continue;
+        boost::program_options::parsed_options parsed(&opt);
+        if (description->semantic()->max_tokens() == 0 && separateValues.count(name)) {
+            // A switch followed by a positional argument
+            parsed.options.push_back(
+                boost::program_options::option(name, std::vector<std::string>()));
+        } else {
+            parsed.options.push_back(boost::program_options::option(name, *values));
+        }
+        if (commandLineValues.count(name)) {
+            boost::program_options::store(parsed, vm);
+        } else {
+            try {
+                boost::program_options::store(parsed, vm);
+            } catch (std::exception& e) {
+                // As for a stream that cannot be parsed, echo the exception,
+                // but carry on
+                std::cerr << e.what() << std::endl;
+            }
         }
-        // Once the stream has been parsed, clear all flags (especially EOF)
-        // and seek back to the start.
-        (*iter)->clear();
-        (*iter)->seekg(0, std::ios_base::beg);
     }
+    // Set the default values of all options not found in the sources
+    boost::program_options::store(boost::program_options::parsed_options(&opt), vm);
 
     return vm;
 }
@@ -9,12 +9,14 @@
 
 #include "include/Configurator.hpp"
 #include "include/ModuleLoader.hpp"
+#include "include/ModuleTiming.hpp"
 
 #include <boost/program_options.hpp>
 #include <stdexcept>
 namespace Nextsim {
 
 const std::string ConfiguredModule::MODULE_PREFIX = "Modules";
+const std::string ConfiguredModule::TIMING_KEY = "timing_interval";
 
 void ConfiguredModule::parseConfigurator()
 {
@@ -30,9 +32,19 @@ void ConfiguredModule::parseConfigurator()
             boost::program_options::value<std::string>()->default_value(defaultStr),
             ("Load an implementation of " + module).c_str());
     }
+    opt.add_options()(addPrefix(TIMING_KEY).c_str(),
+        boost::program_options::value<int>()->default_value(0),
+        "Time one in this many calls to each module, or none if zero.");
 
     boost::program_options::variables_map vm = Configurator::parse(opt);
 
+    int timingInterval = vm[addPrefix(TIMING_KEY)].as<int>();
+    if (timingInterval < 0) {
+        throw std::domain_error("Invalid module timing interval " + std::to_string(timingInterval)
+            + ", which must not be negative.");
+    }
+    ModuleTiming::setInterval(timingInterval);
+
     for (const std::string& module : loader.listModules()) {
         std::string implString = vm[addPrefix(module)].as<std::string>();
         // Only do anything if the retrieved option is not the default value
@@ -10,6 +10,7 @@
 #include "include/DevGrid.hpp"
 #include "include/ElementData.hpp"
 #include "include/IStructure.hpp"
+#include "include/ScopedTimer.hpp"
 
 #include <cstddef>
 #include <ncDim.h>
@@ -17,7 +18,9 @@
 #include <ncFile.h>
 #include <ncVar.h>
 
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 #include <vector>
 
 namespace Nextsim {
@@ -41,8 +44,18 @@ std::string sssName = "sss";
 
 typedef std::map<StringName, std::string> NameMap;
 
-void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap);
-void dumpGroup(const std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap);
+// The chunking and compression of the variables written
+struct Storage {
+    int deflateLevel;
+    bool shuffle;
+    int chunkX;
+    int chunkY;
+};
+
+void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap,
+    int& nx, int& ny, ScopedTimer& partTimer);
+void dumpGroup(const std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap,
+    int nx, int ny, const Storage& storage, ScopedTimer& partTimer);
 
 // See https://isocpp.org/wiki/faq/pointers-to-members#macro-for-ptr-to-memfn
 #define CALL_MEMBER_FN(object, ptrToMember) ((object).*(ptrToMember))
@@ -64,6 +77,13 @@ static const std::map<std::string, ProgDoubleFn> variableFunctions
 
 void DevGridIO::init(std::vector<ElementData>& data, const std::string& filePath) const
 {
+    static const Timer::Id initId = Timer::id("DevGridIO::init");
+    static const Timer::Id metadataId = Timer::id("metadata");
+    static const Timer::Id closeId = Timer::id("close");
+    ScopedTimer initTimer(initId);
+    // Times the opening of the file and the reading of the metadata, and is
+    // then substituted by the timer of each variable
+    ScopedTimer partTimer(metadataId);
     NameMap nameMap = {
         { StringName::METADATA_NODE, IStructure::metadataNodeName() },
         { StringName::DATA_NODE, IStructure::dataNodeName() },
@@ -73,12 +93,32 @@ void DevGridIO::init(std::vector<ElementData>& data, const std::string& filePath
         { StringName::Z_DIM, DevGrid::nIceLayersName },
     };
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
-    initGroup(data, ncFile, nameMap);
+    // The grid takes the size of the restart file
+    initGroup(data, ncFile, nameMap, grid->m_nx, grid->m_ny, partTimer);
+    partTimer.substitute(closeId);
     ncFile.close();
 }
 
+int DevGridIO::initSize(const std::string& filePath) const
+{
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
+    netCDF::NcGroup dataGroup(ncFile.getGroup(IStructure::dataNodeName()));
+    grid->m_nx = dataGroup.getDim(DevGrid::xDimName).getSize();
+    grid->m_ny = dataGroup.getDim(DevGrid::yDimName).getSize();
+    // Get the number of ice layers from the ice temperature data, as initData() does
+    const int layersDim = 2;
+    const int nLayers = dataGroup.getVar(ticeName).getDim(layersDim).getSize();
+    ncFile.close();
+    return nLayers;
+}
+
 void DevGridIO::dump(const std::vector<ElementData>& data, const std::string& filePath) const
 {
+    static const Timer::Id dumpId = Timer::id("DevGridIO::dump");
+    static const Timer::Id metadataId = Timer::id("metadata");
+    static const Timer::Id closeId = Timer::id("close");
+    ScopedTimer dumpTimer(dumpId);
+    ScopedTimer partTimer(metadataId);
     NameMap nameMap = {
         { StringName::METADATA_NODE, IStructure::metadataNodeName() },
         { StringName::DATA_NODE, IStructure::dataNodeName() },
@@ -87,63 +127,88 @@ void DevGridIO::dump(const std::vector<ElementData>& data, const std::string& fi
         { StringName::Y_DIM, DevGrid::yDimName },
         { StringName::Z_DIM, DevGrid::nIceLayersName },
     };
+    const Storage storage = { m_deflateLevel, m_shuffle, m_chunkX, m_chunkY };
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
-    dumpGroup(data, ncFile, nameMap);
+    dumpGroup(data, ncFile, nameMap, grid->m_nx, grid->m_ny, storage, partTimer);
+    // Closing the file flushes any buffered data
+    partTimer.substitute(closeId);
     ncFile.close();
 }
 
-void initMeta(std::vector<ElementData>& data, const netCDF::NcGroup& metaGroup)
+void DevGridIO::setCompression(int deflateLevel, bool shuffle)
+{
+    if (deflateLevel < 0 || deflateLevel > 9)
+        throw std::invalid_argument("DevGridIO: the deflate level must be between 0 and 9");
+    m_deflateLevel = deflateLevel;
+    m_shuffle = shuffle;
+}
+
+void DevGridIO::setChunking(int chunkX, int chunkY)
+{
+    if (chunkX < 0 || chunkY < 0)
+        throw std::invalid_argument("DevGridIO: the chunk sizes must not be negative");
+    m_chunkX = chunkX;
+    m_chunkY = chunkY;
+}
+
+void initMeta(std::vector<ElementData>& data, const netCDF::NcGroup& dataGroup,
+    const NameMap& nameMap, int& nx, int& ny)
 {
-    int nx = DevGrid::nx;
-    data.resize(nx * nx);
+    // The dimensions are held in the data group
+    nx = dataGroup.getDim(nameMap.at(StringName::X_DIM)).getSize();
+    ny = dataGroup.getDim(nameMap.at(StringName::Y_DIM)).getSize();
+    data.resize(nx * ny);
 }
 
-void initData(std::vector<ElementData>& data, const netCDF::NcGroup& dataGroup)
+// Reads a whole variable, rather than one element at a time
+std::vector<double> readVar(const netCDF::NcGroup& dataGroup, const std::string& name, size_t size,
+    ScopedTimer& partTimer)
 {
+    partTimer.substitute("read " + name);
+    std::vector<double> values(size);
+    dataGroup.getVar(name).getVar(values.data());
+    ScopedTimer::timer().addWork(size * sizeof(double), 0);
+    return values;
+}
+
+void initData(std::vector<ElementData>& data, const netCDF::NcGroup& dataGroup, int nx, int ny,
+    ScopedTimer& partTimer)
+{
+    static const Timer::Id unpackId = Timer::id("unpack");
     // Get the number of ice layers from the ice temperature data
     const int layersDim = 2;
     int nLayers = dataGroup.getVar(ticeName).getDim(layersDim).getSize();
-    int nx = DevGrid::nx;
-    for (int i = 0; i < nx; ++i) {
-        for (int j = 0; j < nx; ++j) {
-            int linearIndex = i * nx + j;
-            double hice;
-            double cice;
-            double hsnow;
-            double sst;
-            double sss;
-            std::vector<std::size_t> loc = { std::size_t(i), std::size_t(j) };
-            dataGroup.getVar(hiceName).getVar(loc, &hice);
-            dataGroup.getVar(ciceName).getVar(loc, &cice);
-            dataGroup.getVar(hsnowName).getVar(loc, &hsnow);
-            dataGroup.getVar(sstName).getVar(loc, &sst);
-            dataGroup.getVar(sssName).getVar(loc, &sss);
-            // Retrieve ice temperature data
-
-            std::vector<double> tice(nLayers);
-            for (int l = 0; l < nLayers; ++l) {
-                std::vector<std::size_t> loc3 = { loc[0], loc[1], std::size_t(l) };
-                dataGroup.getVar(ticeName).getVar(loc3, &tice[l]);
-            }
-            data[linearIndex]
-                = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(
-                    tice);
-        }
-    }
+    const size_t nElements = nx * ny;
+    std::vector<double> hice = readVar(dataGroup, hiceName, nElements, partTimer);
+    std::vector<double> cice = readVar(dataGroup, ciceName, nElements, partTimer);
+    std::vector<double> hsnow = readVar(dataGroup, hsnowName, nElements, partTimer);
+    std::vector<double> sst = readVar(dataGroup, sstName, nElements, partTimer);
+    std::vector<double> sss = readVar(dataGroup, sssName, nElements, partTimer);
+    std::vector<double> ticeAll = readVar(dataGroup, ticeName, nElements * nLayers, partTimer);
 
-    for (auto fnNamePair : variableFunctions) {
-        const std::string& name = fnNamePair.first;
-        netCDF::NcVar var(dataGroup.getVar(name));
+    partTimer.substitute(unpackId);
+    // The elements are stored with the y index varying fastest
+    std::vector<double> tice(nLayers);
+    for (size_t linearIndex = 0; linearIndex < nElements; ++linearIndex) {
+        std::copy(ticeAll.begin() + linearIndex * nLayers,
+            ticeAll.begin() + (linearIndex + 1) * nLayers, tice.begin());
+        data[linearIndex] = PrognosticGenerator()
+                                .hice(hice[linearIndex])
+                                .cice(cice[linearIndex])
+                                .sst(sst[linearIndex])
+                                .sss(sss[linearIndex])
+                                .hsnow(hsnow[linearIndex])
+                                .tice(tice);
     }
 }
 
-void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap)
+void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap,
+    int& nx, int& ny, ScopedTimer& partTimer)
 {
-    netCDF::NcGroup metaGroup(grp.getGroup(nameMap.at(StringName::METADATA_NODE)));
     netCDF::NcGroup dataGroup(grp.getGroup(nameMap.at(StringName::DATA_NODE)));
 
-    initMeta(data, metaGroup);
-    initData(data, dataGroup);
+    initMeta(data, dataGroup, nameMap, nx, ny);
+    initData(data, dataGroup, nx, ny, partTimer);
 }
 
 void dumpMeta(
@@ -166,28 +231,50 @@ std::vector<double> gather(const std::vector<ElementData>& data, ProgDoubleFn pF
     return gathered;
 }
 
-void dumpData(
-    const std::vector<ElementData>& data, netCDF::NcGroup& dataGroup, const NameMap& nameMap)
+// Sets the chunking and compression of a variable, before any data is written
+void setStorage(netCDF::NcVar& var, const Storage& storage, std::vector<size_t> chunks)
+{
+    if (storage.chunkX > 0 && storage.chunkY > 0) {
+        var.setChunking(netCDF::NcVar::nc_CHUNKED, chunks);
+    }
+    if (storage.deflateLevel > 0) {
+        var.setCompression(storage.shuffle, true, storage.deflateLevel);
+    }
+}
+
+void dumpData(const std::vector<ElementData>& data, netCDF::NcGroup& dataGroup,
+    const NameMap& nameMap, int nx, int ny, const Storage& storage, ScopedTimer& partTimer)
 {
-    int nx = DevGrid::nx;
     // Create the dimension data, since it has to be in the same group as the
     // data or the parent group
     netCDF::NcDim xDim = dataGroup.addDim(nameMap.at(StringName::X_DIM), nx);
-    netCDF::NcDim yDim = dataGroup.addDim(nameMap.at(StringName::Y_DIM), nx);
+    netCDF::NcDim yDim = dataGroup.addDim(nameMap.at(StringName::Y_DIM), ny);
+    int nLayers = data[0].nIceLayers();
+    netCDF::NcDim zDim = dataGroup.addDim(nameMap.at(StringName::Z_DIM), nLayers);
 
+    // Define all the variables before writing any data
+    const size_t chunkX = std::min(storage.chunkX, nx);
+    const size_t chunkY = std::min(storage.chunkY, ny);
     std::vector<netCDF::NcDim> dims2 = { xDim, yDim };
+    std::map<std::string, netCDF::NcVar> vars;
     for (auto fnNamePair : variableFunctions) {
         const std::string& name = fnNamePair.first;
-        netCDF::NcVar var(dataGroup.addVar(name, netCDF::ncDouble, dims2));
-        std::vector<double> gathered = gather(data, variableFunctions.at(name));
-        var.putVar(gathered.data());
+        vars[name] = dataGroup.addVar(name, netCDF::ncDouble, dims2);
+        setStorage(vars[name], storage, { chunkX, chunkY });
     }
-
-    int nLayers = data[0].nIceLayers();
-    netCDF::NcDim zDim = dataGroup.addDim(nameMap.at(StringName::Z_DIM), nLayers);
     std::vector<netCDF::NcDim> dims3 = { xDim, yDim, zDim };
     netCDF::NcVar iceT(dataGroup.addVar(ticeName, netCDF::ncDouble, dims3));
+    setStorage(iceT, storage, { chunkX, chunkY, static_cast<size_t>(nLayers) });
+
+    for (auto fnNamePair : variableFunctions) {
+        const std::string& name = fnNamePair.first;
+        partTimer.substitute("write " + name);
+        std::vector<double> gathered = gather(data, fnNamePair.second);
+        vars[name].putVar(gathered.data());
+        ScopedTimer::timer().addWork(gathered.size() * sizeof(double), 0);
+    }
 
+    partTimer.substitute("write " + ticeName);
     // Gather the three dimensional data explicitly (until there is more than
     // one three dimensional dataset).
     std::vector<double> tice(data.size() * nLayers);
@@ -198,15 +285,16 @@ void dumpData(
         }
     }
     iceT.putVar(tice.data());
+    ScopedTimer::timer().addWork(tice.size() * sizeof(double), 0);
 }
 
-void dumpGroup(
-    const std::vector<ElementData>& data, netCDF::NcGroup& headGroup, const NameMap& nameMap)
+void dumpGroup(const std::vector<ElementData>& data, netCDF::NcGroup& headGroup,
+    const NameMap& nameMap, int nx, int ny, const Storage& storage, ScopedTimer& partTimer)
 {
     netCDF::NcGroup metaGroup = headGroup.addGroup(nameMap.at(StringName::METADATA_NODE));
     netCDF::NcGroup dataGroup = headGroup.addGroup(nameMap.at(StringName::DATA_NODE));
     dumpMeta(data, metaGroup, nameMap);
-    dumpData(data, dataGroup, nameMap);
+    dumpData(data, dataGroup, nameMap, nx, ny, storage, partTimer);
 }
 
 } /* namespace Nextsim */
@@ -6,20 +6,281 @@
  */
 
 #include "include/DevStep.hpp"
+#include "include/ExternalData.hpp"
+#include "include/IPhysics1d.hpp"
 #include "include/IPrognosticUpdater.hpp"
+#include "include/Logged.hpp"
+#include "include/Precision.hpp"
 #include "include/PrognosticData.hpp"
+#include "include/ScopedTimer.hpp"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 
 namespace Nextsim {
 
+/*
+ * The work of each stage of the column physics per column. The bytes are
+ * those of the fields that the stage reads or writes, each counted once per
+ * stage. The flops are those of the functions that the stage calls, counted
+ * on the ice covered path of the default implementations of the physics
+ * modules. Each call to exp(), pow(), fmin() or fmax() counts as a single
+ * operation and products of constants are folded. Update these with the
+ * functions that they count.
+ */
+namespace {
+const double doubleBytes = sizeof(double);
+const double forcingBytes = sizeof(Precision::Forcing);
+const double diagnosticBytes = sizeof(Precision::Diagnostic);
+
+/*
+ * Derived data: the generation of the cached freezing point, the air
+ * temperature, dew point and pressure, the sea surface temperature and
+ * salinity, the ice surface temperature, the six stored inputs, the ice
+ * concentration and mean ice and snow thicknesses, and the two true
+ * thicknesses written.
+ */
+const double derivedDataBytes
+    = sizeof(unsigned) + 3 * forcingBytes + (3 + 6 + 3 + 2) * doubleBytes;
+// The true thicknesses
+const double derivedDataFlops = 2;
+// Each recalculated field is written, and the air density and heat capacity
+// read the specific humidity of the air
+const double derivedFieldBytes[IPhysics1d::N_DERIVED_FIELDS]
+    = { diagnosticBytes, diagnosticBytes, diagnosticBytes, 2 * diagnosticBytes,
+          2 * diagnosticBytes };
+// SpecificHumidity::operator(): est() 10, f() 7 and the ratio 6
+const double specificHumidityFlops = 10 + 7 + 6;
+// The gas constant of the wet air 3 and the density 3, and the heat capacity 2
+const double derivedFieldFlops[IPhysics1d::N_DERIVED_FIELDS]
+    = { specificHumidityFlops, specificHumidityFlops, specificHumidityFlops, 3 + 3, 2 };
+
+/*
+ * Fluxes: six derived fields read and the drag pressure written, the air
+ * temperature and pressure, the incoming shortwave and longwave and the
+ * mixed layer heat capacity, the sea surface temperature, ice surface
+ * temperature, concentration, snow thickness and freezing point, and the
+ * sublimation rate and the three heat flux terms written.
+ */
+const double fluxesBytes = 7 * diagnosticBytes + 5 * forcingBytes + (5 + 4) * doubleBytes;
+/*
+ * massFluxOpenWater() 4, momentumFluxOpenWater() 6, heatFluxOpenWater() 25,
+ * massFluxIceAtmosphere() 4, heatFluxIceAtmosphere() 72, of which
+ * SpecificHumidityIce::dq_dT() is 41, and BasicIceOceanHeatFlux::flux() 3.
+ */
+const double fluxesFlops = 4 + 6 + 25 + 4 + 72 + 3;
+
+/*
+ * Thermodynamics: the mean ice and snow thicknesses, concentration, ice
+ * surface temperature, freezing point and sea surface temperature, the
+ * snowfall and mixed layer heat capacity, the updated concentration, true
+ * thicknesses and surface temperature read and written, the four fluxes of
+ * the previous stage, and the new ice and ice from snow written.
+ */
+const double thermodynamicsBytes = 2 * forcingBytes + (6 + 2 * 4 + 4 + 2) * doubleBytes;
+// ThermoIce0::calculate() 41, newIceFormation() 12 and lateralGrowth() 21
+const double thermodynamicsFlops = 41 + 12 + 21;
+
+/*
+ * Integration: the updated concentration and true thicknesses read, the
+ * concentration and mean thicknesses written, and the two vectors of ice
+ * temperatures.
+ */
+const double integrationBytes = (3 + 3) * doubleBytes + 2 * sizeof(std::vector<double>);
+// The mean thicknesses from the updated true thicknesses
+const double integrationFlops = 2;
+
+const double stageColumnBytes[DevStep::N_STAGES]
+    = { derivedDataBytes, fluxesBytes, thermodynamicsBytes, integrationBytes };
+const double stageColumnFlops[DevStep::N_STAGES]
+    = { derivedDataFlops, fluxesFlops, thermodynamicsFlops, integrationFlops };
+// The ice temperatures of each layer are read and written by the integration
+const double stageLayerBytes[DevStep::N_STAGES] = { 0, 0, 0, 2 * doubleBytes };
+}
+
+int DevStep::s_stageSampling = 64;
+
 void DevStep::iterate(const Iterator::Duration& dt)
 {
+    static const Timer::Id stepId = Timer::id("DevStep");
+    static const Timer::Id columnsId = Timer::id("column physics");
+
+    ScopedTimer stepTimer(stepId);
     PrognosticData::setTimestep(dt);
-    for (pStructure->cursor = 0; pStructure->cursor; ++pStructure->cursor) {
-        auto& data = *pStructure->cursor;
-        data.updateDerivedData(data, data, data);
-        data.calculate(data, data, data);
-        data.updateAndIntegrate(data);
+    // Count the derived data recalculated during this step only
+    IPhysics1d::derivedDataReport().reset();
+    healthCheck.reset();
+
+    ScopedTimer columnsTimer(columnsId);
+    HealthCheck* check = checkHealth ? &healthCheck : nullptr;
+    long nColumns = 0;
+    long nLayers = 0;
+    ElementData* first;
+    ElementData* last;
+    if (pStructure->contiguousData(first, last)) {
+        nLayers = stepColumns(first, last, check);
+        nColumns = last - first;
+    } else {
+        // One column at a time, through the cursor
+        for (pStructure->cursor = 0; pStructure->cursor; ++pStructure->cursor) {
+            ElementData& data = *pStructure->cursor;
+            nLayers += stepColumns(&data, &data + 1, check, nColumns++);
+        }
+    }
+    const IPhysics1d::DerivedDataReport& report = IPhysics1d::derivedDataReport();
+    ScopedTimer::timer().addWork(columnBytes(report, nLayers), columnFlops(report));
+    // Report the hardware events of the column physics per column
+    ScopedTimer::timer().countItems(nColumns);
+    ++nSteps;
+
+    // Report the derived data recalculations, a line per field to fit the
+    // messages of the logger
+    if (Logged::isEnabled(Logged::DEBUG)) {
+        Logged::debug("DevStep: step ", nSteps, ": derived data recalculated in ",
+            report.columns(), " columns");
+        for (int field = 0; field < IPhysics1d::N_DERIVED_FIELDS; ++field) {
+            const IPhysics1d::DerivedField derived = static_cast<IPhysics1d::DerivedField>(field);
+            Logged::debug("    ", IPhysics1d::DerivedDataReport::fieldName(derived), " = ",
+                report.recalculated(derived));
+        }
+    }
+
+    // Stop before the failure propagates any further
+    if (healthCheck.failed()) {
+        std::stringstream message;
+        message << "DevStep: step " << nSteps << ": ";
+        healthCheck.report(message);
+        throw std::runtime_error(message.str());
+    }
+}
+
+const char* DevStep::stageName(Stage stage)
+{
+    static const std::array<const char*, N_STAGES> names
+        = { "derived data", "fluxes", "thermodynamics", "integration" };
+    return names[stage];
+}
+
+void DevStep::stepColumnStages(ElementData& data)
+{
+    static const std::array<Timer::Id, N_STAGES> stageIds
+        = { Timer::id(stageName(DERIVED_DATA)), Timer::id(stageName(FLUXES)),
+              Timer::id(stageName(THERMODYNAMICS)), Timer::id(stageName(INTEGRATION)) };
+    Timer& timer = ScopedTimer::timer();
+    const long nLayers = data.nIceLayers();
+
+    // The derived fields recalculated in this column decide the work of its
+    // derived data
+    const IPhysics1d::DerivedDataReport& report = IPhysics1d::derivedDataReport();
+    const IPhysics1d::DerivedDataReport before = report;
+    IPhysics1d::DerivedDataReport column;
+    column.countColumn();
+
+    timer.tick(stageIds[DERIVED_DATA]);
+    data.cacheDerivedQuantities();
+    data.updateDerivedData(data, data, data);
+    for (int field = 0; field < IPhysics1d::N_DERIVED_FIELDS; ++field) {
+        const IPhysics1d::DerivedField derived = static_cast<IPhysics1d::DerivedField>(field);
+        if (report.recalculated(derived) != before.recalculated(derived))
+            column.countRecalculation(derived);
+    }
+    timer.addWork(
+        stageBytes(DERIVED_DATA, column, nLayers), stageFlops(DERIVED_DATA, column));
+    timer.countItems(1);
+    timer.tock();
+
+    timer.tick(stageIds[FLUXES]);
+    data.calculateFluxes(data, data, data);
+    timer.addWork(stageBytes(FLUXES, column, nLayers), stageFlops(FLUXES, column));
+    timer.countItems(1);
+    timer.tock();
+
+    timer.tick(stageIds[THERMODYNAMICS]);
+    data.calculateThermodynamics(data, data, data);
+    timer.addWork(
+        stageBytes(THERMODYNAMICS, column, nLayers), stageFlops(THERMODYNAMICS, column));
+    timer.countItems(1);
+    timer.tock();
+
+    timer.tick(stageIds[INTEGRATION]);
+    data.updateAndIntegrate(data);
+    timer.addWork(stageBytes(INTEGRATION, column, nLayers), stageFlops(INTEGRATION, column));
+    timer.countItems(1);
+    timer.tock();
+}
+
+long DevStep::stepColumns(
+    ElementData* first, ElementData* last, HealthCheck* check, long firstIndex)
+{
+    static thread_local int sinceSample = 0;
+    long nLayers = 0;
+    for (ElementData* column = first; column != last; ++column) {
+        if (s_stageSampling > 0 && ++sinceSample >= s_stageSampling) {
+            sinceSample = 0;
+            stepColumnStages(*column);
+        } else {
+            stepColumn(*column);
+        }
+        nLayers += column->nIceLayers();
+        // The health check reads the updated fields while they are in cache
+        if (check) {
+            const unsigned failures = HealthCheck::check(*column);
+            if (failures)
+                check->record(firstIndex + (column - first), *column, failures);
+        }
+    }
+    return nLayers;
+}
+
+double DevStep::stageFlops(Stage stage, const IPhysics1d::DerivedDataReport& report)
+{
+    double flops = report.columns() * stageColumnFlops[stage];
+    if (stage == DERIVED_DATA) {
+        for (int field = 0; field < IPhysics1d::N_DERIVED_FIELDS; ++field) {
+            flops += report.recalculated(static_cast<IPhysics1d::DerivedField>(field))
+                * derivedFieldFlops[field];
+        }
+    }
+    return flops;
+}
+
+double DevStep::stageBytes(
+    Stage stage, const IPhysics1d::DerivedDataReport& report, long nLayers)
+{
+    double bytes = report.columns() * stageColumnBytes[stage] + nLayers * stageLayerBytes[stage];
+    if (stage == DERIVED_DATA) {
+        for (int field = 0; field < IPhysics1d::N_DERIVED_FIELDS; ++field) {
+            bytes += report.recalculated(static_cast<IPhysics1d::DerivedField>(field))
+                * derivedFieldBytes[field];
+        }
+    }
+    return bytes;
+}
+
+double DevStep::columnFlops(const IPhysics1d::DerivedDataReport& report)
+{
+    double flops = 0;
+    for (int stage = 0; stage < N_STAGES; ++stage) {
+        flops += stageFlops(static_cast<Stage>(stage), report);
     }
+    return flops;
+}
+
+double DevStep::columnBytes(const IPhysics1d::DerivedDataReport& report, long nLayers)
+{
+    double bytes = 0;
+    for (int stage = 0; stage < N_STAGES; ++stage) {
+        bytes += stageBytes(static_cast<Stage>(stage), report, nLayers);
+    }
+    return bytes;
+}
+
+void DevStep::setHealthCheck(int maxColumns)
+{
+    checkHealth = (maxColumns > 0);
+    healthCheck = HealthCheck(maxColumns);
 }
 
 } /* namespace Nextsim */
@@ -22,7 +22,7 @@ ElementData::ElementData(int nIceLayers)
 ElementData::ElementData(const ElementData& src)
 {
     *this = static_cast<PrognosticData>(src);
-    *this = static_cast<ExternalData>(src);
+    *this = static_cast<const ExternalData&>(src);
     *this = static_cast<PhysicsData>(src);
     this->m_physicsImplData = std::move(ModuleLoader::getLoader().getInstance<IPhysics1d>());
     *(this->m_physicsImplData) = *(src.m_physicsImplData);
@@ -32,7 +32,7 @@ ElementData::ElementData(const ElementData& src)
 ElementData::ElementData(ElementData&& src)
 {
     *this = static_cast<PrognosticData>(src);
-    *this = static_cast<ExternalData>(src);
+    *this = static_cast<const ExternalData&>(src);
     *this = static_cast<PhysicsData>(src);
     this->m_physicsImplData = std::move(src.m_physicsImplData);
 }
@@ -44,7 +44,7 @@ ElementData& ElementData::operator=(ElementData other)
         return *this;
 
     *this = static_cast<PrognosticData>(other);
-    *this = static_cast<ExternalData>(other);
+    *this = static_cast<const ExternalData&>(other);
     *this = static_cast<PhysicsData>(other);
     this->m_physicsImplData = std::move(ModuleLoader::getLoader().getInstance<IPhysics1d>());
     *(this->m_physicsImplData) = *(other.m_physicsImplData);
@@ -59,7 +59,7 @@ ElementData& ElementData::operator=(ElementData&& other)
         return *this;
 
     *this = static_cast<PrognosticData>(other);
-    *this = static_cast<ExternalData>(other);
+    *this = static_cast<const ExternalData&>(other);
     *this = static_cast<PhysicsData>(other);
     this->m_physicsImplData = std::move(other.m_physicsImplData);
 
@@ -86,4 +86,16 @@ void ElementData::calculate(
     m_physicsImplData->calculate(prog, exter, phys);
 }
 
+void ElementData::calculateFluxes(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
+    m_physicsImplData->calculateFluxes(prog, exter, phys);
+}
+
+void ElementData::calculateThermodynamics(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
+    m_physicsImplData->calculateThermodynamics(prog, exter, phys);
+}
+
 } /* namespace Nextsim */
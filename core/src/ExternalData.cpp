@@ -8,4 +8,16 @@
 
 namespace Nextsim {
 
+ExternalData::ExternalData()
+    : m_tair(0)
+    , m_dair(0)
+    , m_slp(0)
+    , m_mixrat(0)
+    , m_Qsw_in(0)
+    , m_Qlw_in(0)
+    , m_mld(0)
+    , m_snowfall(0)
+{
+}
+
 } /* namespace Nextsim */
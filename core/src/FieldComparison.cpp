@@ -0,0 +1,196 @@
+/*!
+ * @file FieldComparison.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/FieldComparison.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace Nextsim {
+
+// One bin of identical values, one for each power of two up to 2^63 and one
+// for NaN mismatches
+const int FieldComparison::ulpBins = 66;
+
+// Fewer values than this are compared on one thread
+static const size_t valuesPerThread = 1 << 16;
+
+FieldComparison::FieldComparison(int nThreads)
+    : m_nThreads(nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency()))
+    , m_default({ 0, 0 })
+{
+}
+
+const FieldComparison::Tolerance& FieldComparison::tolerance(const std::string& field) const
+{
+    auto iter = m_tolerances.find(field);
+    return (iter == m_tolerances.end()) ? m_default : iter->second;
+}
+
+void FieldComparison::readTolerances(std::istream& is)
+{
+    std::string line;
+    while (std::getline(is, line)) {
+        std::stringstream fields(line);
+        std::string name;
+        if (!(fields >> name) || name[0] == '#')
+            continue;
+        Tolerance tol;
+        std::string rest;
+        if (!(fields >> tol.absolute >> tol.relative) || (fields >> rest) || tol.absolute < 0
+            || tol.relative < 0)
+            throw std::invalid_argument("FieldComparison: invalid tolerance line: " + line);
+        if (name == "*") {
+            m_default = tol;
+        } else {
+            m_tolerances[name] = tol;
+        }
+    }
+}
+
+unsigned long long FieldComparison::ulpDistance(double a, double b)
+{
+    // Map the doubles onto integers of the same order, with both zeros at zero
+    int64_t ia;
+    int64_t ib;
+    std::memcpy(&ia, &a, sizeof(double));
+    std::memcpy(&ib, &b, sizeof(double));
+    if (ia < 0)
+        ia = std::numeric_limits<int64_t>::min() - ia;
+    if (ib < 0)
+        ib = std::numeric_limits<int64_t>::min() - ib;
+    // The difference of unsigned values does not overflow
+    return (ia > ib) ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib)
+                     : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia);
+}
+
+int FieldComparison::ulpBin(unsigned long long distance)
+{
+    int bin = 0;
+    while (distance > 0) {
+        distance >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+std::string FieldComparison::ulpBinLabel(int bin)
+{
+    if (bin == 0)
+        return "0";
+    if (bin == ulpBins - 1)
+        return "NaN";
+    if (bin == 1)
+        return "1";
+    std::stringstream label;
+    if (bin <= 21) {
+        label << (1ull << (bin - 1)) << "-" << (1ull << bin) - 1;
+    } else {
+        label << "2^" << bin - 1 << "-2^" << bin;
+    }
+    return label.str();
+}
+
+// Compares the values of one range of indices
+static void compareRange(const double* reference, const double* test, size_t begin, size_t end,
+    const FieldComparison::Tolerance& tol, FieldComparison::Result& result)
+{
+    for (size_t i = begin; i < end; ++i) {
+        const double ref = reference[i];
+        const double value = test[i];
+        bool failed;
+        if (std::isnan(ref) || std::isnan(value)) {
+            failed = !(std::isnan(ref) && std::isnan(value));
+            ++result.ulpHistogram[failed ? FieldComparison::ulpBins - 1 : 0];
+        } else {
+            // Equal infinities do not differ
+            const double absolute = (value == ref) ? 0 : std::fabs(value - ref);
+            failed = !(absolute <= tol.absolute + tol.relative * std::fabs(ref));
+            result.maxAbsolute = std::max(result.maxAbsolute, absolute);
+            if (ref != 0)
+                result.maxRelative = std::max(result.maxRelative, absolute / std::fabs(ref));
+            ++result.ulpHistogram[FieldComparison::ulpBin(
+                FieldComparison::ulpDistance(ref, value))];
+        }
+        if (failed) {
+            if (result.failures == 0)
+                result.firstFailure = i;
+            ++result.failures;
+        }
+    }
+}
+
+FieldComparison::Result FieldComparison::compare(const std::string& name,
+    const std::vector<double>& reference, const std::vector<double>& test) const
+{
+    if (reference.size() != test.size())
+        throw std::invalid_argument("FieldComparison: the field " + name + " differs in size");
+
+    const size_t size = reference.size();
+    const Tolerance& tol = tolerance(name);
+    const Result empty = { name, size, 0, size, 0, 0, std::vector<size_t>(ulpBins, 0) };
+    const int nThreads = static_cast<int>(
+        std::max<size_t>(1, std::min<size_t>(m_nThreads, size / valuesPerThread)));
+
+    // Compare contiguous blocks of the field on each thread
+    std::vector<Result> partial(nThreads, empty);
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nThreads; ++t) {
+        threads.emplace_back(compareRange, reference.data(), test.data(), size * t / nThreads,
+            size * (t + 1) / nThreads, std::cref(tol), std::ref(partial[t]));
+    }
+    compareRange(reference.data(), test.data(), 0, size / nThreads, tol, partial[0]);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Result result = empty;
+    for (const Result& part : partial) {
+        if (part.failures > 0 && result.failures == 0)
+            result.firstFailure = part.firstFailure;
+        result.failures += part.failures;
+        result.maxAbsolute = std::max(result.maxAbsolute, part.maxAbsolute);
+        result.maxRelative = std::max(result.maxRelative, part.maxRelative);
+        for (int bin = 0; bin < ulpBins; ++bin) {
+            result.ulpHistogram[bin] += part.ulpHistogram[bin];
+        }
+    }
+    return result;
+}
+
+std::ostream& FieldComparison::writeReport(
+    const std::vector<Result>& results, std::ostream& os) const
+{
+    os << std::left << std::setw(16) << "field" << std::right << std::setw(12) << "size"
+       << std::setw(10) << "failures" << std::setw(14) << "max_abs" << std::setw(14) << "max_rel"
+       << std::setw(12) << "abs_tol" << std::setw(12) << "rel_tol" << "  status" << std::endl;
+    for (const Result& result : results) {
+        const Tolerance& tol = tolerance(result.name);
+        os << std::left << std::setw(16) << result.name << std::right << std::setw(12)
+           << result.size << std::setw(10) << result.failures << std::setw(14)
+           << result.maxAbsolute << std::setw(14) << result.maxRelative << std::setw(12)
+           << tol.absolute << std::setw(12) << tol.relative << "  "
+           << (result.passed() ? "pass" : "FAIL");
+        if (!result.passed())
+            os << " (first at index " << result.firstFailure << ")";
+        os << std::endl << "    ULPs";
+        for (int bin = 0; bin < ulpBins; ++bin) {
+            if (result.ulpHistogram[bin] > 0)
+                os << "  " << ulpBinLabel(bin) << ": " << result.ulpHistogram[bin];
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,72 @@
+/*!
+ * @file HealthCheck.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/HealthCheck.hpp"
+
+#include <utility>
+
+namespace Nextsim {
+
+const int HealthCheck::defaultMaxColumns;
+
+HealthCheck::HealthCheck(int maxColumns)
+    : m_maxColumns(maxColumns)
+    , m_nFailed(0)
+{
+}
+
+void HealthCheck::record(long index, const PrognosticData& data, unsigned failures)
+{
+    ++m_nFailed;
+    if (static_cast<int>(m_columns.size()) < m_maxColumns)
+        m_columns.push_back({ index, failures, data });
+}
+
+void HealthCheck::reset()
+{
+    m_nFailed = 0;
+    m_columns.clear();
+}
+
+void HealthCheck::report(std::ostream& os) const
+{
+    os << m_nFailed << " column" << ((m_nFailed == 1) ? "" : "s") << " failed the health check";
+    if (m_nFailed > static_cast<long>(m_columns.size()))
+        os << ", the first " << m_columns.size() << " of which are";
+    os << std::endl;
+    for (const Column& column : m_columns) {
+        const PrognosticData& state = column.state;
+        os << "  column " << column.index << ": " << failureNames(column.failures) << std::endl;
+        os << "    ice thickness " << state.iceThickness() << " m, concentration "
+           << state.iceConcentration() << ", snow thickness " << state.snowThickness()
+           << " m" << std::endl;
+        os << "    sea surface temperature " << state.seaSurfaceTemperature()
+           << " ˚C, salinity " << state.seaSurfaceSalinity() << " psu" << std::endl;
+        os << "    ice temperatures";
+        for (double tice : state.iceTemperatures()) {
+            os << " " << tice;
+        }
+        os << " ˚C" << std::endl;
+    }
+}
+
+std::string HealthCheck::failureNames(unsigned failures)
+{
+    static const std::pair<Failure, const char*> names[] = {
+        { NOT_FINITE, "not finite" },
+        { CONCENTRATION, "concentration outside [0, 1]" },
+        { NEGATIVE_THICKNESS, "negative thickness" },
+        { TOO_WARM, "ice above melting" },
+    };
+    std::string list;
+    for (const auto& name : names) {
+        if (failures & name.first)
+            list += (list.empty() ? "" : ", ") + std::string(name.second);
+    }
+    return list;
+}
+
+} /* namespace Nextsim */
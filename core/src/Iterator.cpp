@@ -6,6 +6,8 @@
 
 #include "include/Iterator.hpp"
 
+#include "include/Telemetry.hpp"
+
 #include <sstream>
 
 namespace Nextsim {
@@ -14,16 +16,20 @@ Iterator::NullIterant Iterator::nullIterant;
 
 Iterator::Iterator()
     : iterant(&nullIterant)
+    , telemetry(nullptr)
 {
 }
 
 Iterator::Iterator(Iterant* iterant)
     : iterant(iterant)
+    , telemetry(nullptr)
 {
 }
 
 void Iterator::setIterant(Iterant* iterant) { this->iterant = iterant; }
 
+void Iterator::setTelemetry(Telemetry* telemetry) { this->telemetry = telemetry; }
+
 void Iterator::setStartStopStep(
     Iterator::TimePoint startTime, Iterator::TimePoint stopTime, Iterator::Duration timestep)
 {
@@ -50,15 +56,29 @@ void Iterator::parseAndSet(const std::string& startTimeStr, const std::string& s
     }
 }
 
+int Iterator::nSteps() const
+{
+    if (timestep <= 0 || stopTime <= startTime)
+        return 0;
+    return (stopTime - startTime + timestep - 1) / timestep;
+}
+
 void Iterator::run()
 {
     iterant->start(startTime);
+    if (telemetry)
+        telemetry->start(startTime, stopTime);
 
-    for (auto t = startTime; t < stopTime; t += timestep) {
+    auto t = startTime;
+    for (; t < stopTime; t += timestep) {
         iterant->iterate(timestep);
+        if (telemetry)
+            telemetry->step(t + timestep);
     }
 
     iterant->stop(stopTime);
+    if (telemetry)
+        telemetry->finish(stopTime);
 }
 
 } /* namespace Nextsim */
@@ -6,39 +6,356 @@
 
 #include "include/Logged.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
 namespace Nextsim {
 
-// TODO Empty implementations of the declared functions
-void Logged::log(const std::string& message, Logged::level lvl)
-{
-    switch (lvl) {
-    case (INFO):
-        info(message);
-        break;
-    case (DEBUG):
-    case (NOTICE):
-    case (WARNING):
-    case (ERROR):
-    case (CRITICAL):
-    case (ALERT):
-        // TODO implement these levels
-        break;
-    case (EMERGENCY):
-        emergency(message);
-        break;
-    default:
-        break;
+std::atomic<int> Logged::s_minimumLevel(Logged::INFO);
+
+namespace {
+
+typedef std::chrono::system_clock Clock;
+
+static const char* levelNames[]
+    = { "DEBUG", "INFO", "NOTICE", "WARNING", "ERROR", "CRITICAL", "ALERT", "EMERGENCY" };
+
+// An argument as held in a record, with strings held in the text of the record
+struct Slot {
+    Logged::Argument::Type type;
+    union {
+        long long signedValue;
+        unsigned long long unsignedValue;
+        double realValue;
+        struct {
+            unsigned short offset;
+            unsigned short length;
+        } text;
+    };
+};
+
+// One message, enqueued without any allocation
+struct Record {
+    Logged::level lvl;
+    Clock::time_point time;
+    int nSlots;
+    int textSize;
+    bool truncated;
+    Slot slots[Logged::maxArguments];
+    char text[Logged::textCapacity];
+};
+
+/*
+ * A ring buffer of records written by one thread and read by the background
+ * thread. The producer owns head and the consumer owns tail, so neither
+ * needs a lock.
+ */
+struct Ring {
+    Ring(size_t capacity, int threadIndex)
+        : records(capacity)
+        , mask(capacity - 1)
+        , threadIndex(threadIndex)
+        , head(0)
+        , tail(0)
+        , dropped(0)
+        , retired(false)
+    {
+    }
+
+    std::vector<Record> records;
+    const size_t mask;
+    const int threadIndex;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<size_t> dropped;
+    // Set when the thread exits, after which the ring is freed once empty
+    std::atomic<bool> retired;
+};
+
+// The rings of all threads and the background thread that writes them
+class Backend {
+public:
+    Backend()
+        : stream(&std::cout)
+        , bufferSize(1024)
+        , nThreads(0)
+        , stopping(false)
+        , writer(&Backend::run, this)
+    {
+    }
+
+    ~Backend()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+        drain();
+    }
+
+    // Creates the ring of a new thread
+    Ring* addRing()
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.emplace_back(new Ring(bufferSize, nThreads++));
+        return rings.back().get();
+    }
+
+    // Formats and writes the records of all rings, in time order
+    void drain()
+    {
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        std::vector<Ring*> current;
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            for (auto& ring : rings) {
+                current.push_back(ring.get());
+            }
+        }
+        std::vector<std::pair<Clock::time_point, std::string>> lines;
+        for (Ring* ring : current) {
+            const size_t head = ring->head.load(std::memory_order_acquire);
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            for (; tail != head; ++tail) {
+                const Record& record = ring->records[tail & ring->mask];
+                lines.emplace_back(record.time, format(record, ring->threadIndex));
+            }
+            ring->tail.store(tail, std::memory_order_release);
+            const size_t dropped = ring->dropped.exchange(0);
+            if (dropped > 0) {
+                Record record;
+                record.lvl = Logged::WARNING;
+                record.time = Clock::now();
+                record.nSlots = 0;
+                record.truncated = false;
+                std::stringstream message;
+                message << dropped << " messages dropped from a full log buffer";
+                lines.emplace_back(
+                    record.time, format(record, ring->threadIndex) + message.str());
+            }
+        }
+        if (lines.empty()) {
+            removeRetired();
+            return;
+        }
+        std::stable_sort(lines.begin(), lines.end(),
+            [](const std::pair<Clock::time_point, std::string>& a,
+                const std::pair<Clock::time_point, std::string>& b) { return a.first < b.first; });
+        for (const auto& line : lines) {
+            *stream << line.second << '\n';
+        }
+        stream->flush();
+        removeRetired();
+    }
+
+    void setStream(std::ostream& os)
+    {
+        drain();
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        stream = &os;
+    }
+
+    void setBufferSize(size_t nMessages)
+    {
+        size_t capacity = 1;
+        while (capacity < nMessages) {
+            capacity *= 2;
+        }
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        bufferSize = capacity;
+    }
+
+private:
+    void run()
+    {
+        // The producers never wait, so the writer polls for messages
+        const std::chrono::milliseconds interval(10);
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stopping) {
+            lock.unlock();
+            drain();
+            lock.lock();
+            wake.wait_for(lock, interval, [this]() { return stopping; });
+        }
+    }
+
+    // Frees the rings of exited threads once they are empty. Called by the
+    // consumer with drainMutex held.
+    void removeRetired()
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+                        [](const std::unique_ptr<Ring>& ring) {
+                            return ring->retired.load()
+                                && ring->head.load() == ring->tail.load()
+                                && ring->dropped.load() == 0;
+                        }),
+            rings.end());
     }
+
+    static std::string format(const Record& record, int threadIndex)
+    {
+        std::stringstream line;
+        const std::time_t seconds = Clock::to_time_t(record.time);
+        const long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            record.time.time_since_epoch())
+                                           .count()
+            % 1000;
+        char timeString[32];
+        std::tm tmStruct;
+        localtime_r(&seconds, &tmStruct);
+        std::strftime(timeString, sizeof(timeString), "%Y-%m-%d %H:%M:%S", &tmStruct);
+        line << timeString << '.' << std::setw(3) << std::setfill('0') << milliseconds
+             << std::setfill(' ') << ' ' << std::left << std::setw(9) << levelNames[record.lvl]
+             << std::right << '[' << threadIndex << "] ";
+        for (int i = 0; i < record.nSlots; ++i) {
+            const Slot& slot = record.slots[i];
+            switch (slot.type) {
+            case (Logged::Argument::STRING):
+                line.write(record.text + slot.text.offset, slot.text.length);
+                break;
+            case (Logged::Argument::CHARACTER):
+                line << static_cast<char>(slot.signedValue);
+                break;
+            case (Logged::Argument::BOOLEAN):
+                line << (slot.signedValue ? "true" : "false");
+                break;
+            case (Logged::Argument::SIGNED):
+                line << slot.signedValue;
+                break;
+            case (Logged::Argument::UNSIGNED):
+                line << slot.unsignedValue;
+                break;
+            case (Logged::Argument::REAL):
+                line << slot.realValue;
+                break;
+            }
+        }
+        if (record.truncated)
+            line << "...";
+        return line.str();
+    }
+
+    std::ostream* stream;
+    size_t bufferSize;
+    int nThreads;
+
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    // Held by whichever thread is consuming the rings
+    std::mutex drainMutex;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread writer;
+};
+
+Backend& backend()
+{
+    static Backend instance;
+    return instance;
 }
 
-void Logged::info(const std::string& message)
+// The ring of the calling thread, retired when the thread exits
+class ThreadRing {
+public:
+    ThreadRing()
+        : ring(backend().addRing())
+    {
+    }
+    ~ThreadRing() { ring->retired.store(true); }
+
+    Ring* const ring;
+};
+
+} /* anonymous namespace */
+
+void Logged::enqueue(level lvl, std::initializer_list<Argument> arguments)
 {
-    // TODO Replace empty implementation
+    static thread_local ThreadRing threadRing;
+    Ring& ring = *threadRing.ring;
+
+    const size_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) > ring.mask) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Record& record = ring.records[head & ring.mask];
+    record.lvl = lvl;
+    record.time = Clock::now();
+    record.nSlots = 0;
+    record.textSize = 0;
+    record.truncated = false;
+    for (const Argument& argument : arguments) {
+        if (record.nSlots == maxArguments) {
+            record.truncated = true;
+            break;
+        }
+        Slot& slot = record.slots[record.nSlots++];
+        slot.type = argument.type;
+        switch (argument.type) {
+        case (Argument::STRING): {
+            const size_t length
+                = std::min<size_t>(argument.length, textCapacity - record.textSize);
+            std::memcpy(record.text + record.textSize, argument.string, length);
+            slot.text.offset = record.textSize;
+            slot.text.length = length;
+            record.textSize += length;
+            record.truncated = (length < argument.length);
+            break;
+        }
+        case (Argument::UNSIGNED):
+            slot.unsignedValue = argument.unsignedValue;
+            break;
+        case (Argument::REAL):
+            slot.realValue = argument.realValue;
+            break;
+        default:
+            slot.signedValue = argument.signedValue;
+            break;
+        }
+        if (record.truncated)
+            break;
+    }
+    ring.head.store(head + 1, std::memory_order_release);
+
+    // Severe messages are written at once, in case the model is about to fail
+    if (lvl >= ERROR)
+        flush();
 }
 
-void Logged::emergency(const std::string& message)
+Logged::level Logged::levelFromString(const std::string& name)
 {
-    // TODO Replace empty implementation
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    for (int lvl = DEBUG; lvl <= EMERGENCY; ++lvl) {
+        if (upper == levelNames[lvl])
+            return static_cast<level>(lvl);
+    }
+    throw std::invalid_argument("Logged: unknown log level " + name);
 }
 
+std::string Logged::levelName(level lvl) { return levelNames[lvl]; }
+
+void Logged::setStream(std::ostream& os) { backend().setStream(os); }
+
+void Logged::flush() { backend().drain(); }
+
+void Logged::setBufferSize(size_t nMessages) { backend().setBufferSize(nMessages); }
+
 } /* namespace Nextsim */
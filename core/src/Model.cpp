@@ -6,17 +6,24 @@
 
 #include "include/Model.hpp"
 
+#include "include/CapacityPlan.hpp"
 #include "include/Configurator.hpp"
 #include "include/DevGrid.hpp"
 #include "include/DevStep.hpp"
 #include "include/DummyExternalData.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/Roofline.hpp"
+#include "include/Sampler.hpp"
+#include "include/ScopedTimer.hpp"
 #include "include/StructureFactory.hpp"
+#include "include/Timer.hpp"
 
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
-// TODO Replace with real logging
-#include <iostream>
-
 namespace Nextsim {
 
 template <>
@@ -26,8 +33,27 @@ const std::map<int, std::string> Configured<Model>::keyMap = {
     { Model::STOPTIME_KEY, "model.stop" },
     { Model::RUNLENGTH_KEY, "model.run_length" },
     { Model::TIMESTEP_KEY, "model.time_step" },
+    { Model::TRACEFILE_KEY, "model.trace_file" },
+    { Model::TRACEEVENTS_KEY, "model.trace_events" },
+    { Model::HWCOUNTERS_KEY, "model.hardware_counters" },
+    { Model::ALLOCATIONS_KEY, "model.count_allocations" },
+    { Model::TIMERREPORT_KEY, "model.timer_report" },
+    { Model::PROFILEFILE_KEY, "model.profile_file" },
+    { Model::PROFILEFREQUENCY_KEY, "model.profile_frequency" },
+    { Model::PROFILESAMPLES_KEY, "model.profile_samples" },
+    { Model::METRICSFILE_KEY, "model.metrics_file" },
+    { Model::METRICSINTERVAL_KEY, "model.metrics_interval" },
+    { Model::ROOFLINE_KEY, "model.roofline" },
+    { Model::LOGLEVEL_KEY, "model.log_level" },
+    { Model::HEALTHCHECK_KEY, "model.health_check" },
+    { Model::HEALTHCHECKCOLUMNS_KEY, "model.health_check_columns" },
 };
 
+// Default number of timer events held for the trace of each thread
+static const int defaultTraceEvents = 1 << 20;
+// Default number of time steps between the lines of the metrics file
+static const int defaultMetricsInterval = 10;
+
 Model::Model()
 {
     iterator.setIterant(&modelStep);
@@ -35,6 +61,11 @@ Model::Model()
     dataStructure = nullptr;
 
     finalFileName = "restart.nc";
+
+    profileFrequency = 0;
+    profileSamples = 0;
+
+    writeRestart = true;
 }
 
 Model::~Model()
@@ -45,6 +76,8 @@ Model::~Model()
      * restart file is unlikely to be valid or otherwise stored properly, and
      * we abandon the writing.
      */
+    if (!writeRestart)
+        return;
     try {
         writeRestartFile();
     } catch (std::exception& e) {
@@ -52,7 +85,7 @@ Model::~Model()
     }
 }
 
-void Model::configure()
+void Model::configureTime()
 {
     std::string startTimeStr
         = Configured::getConfiguration(keyMap.at(STARTTIME_KEY), std::string());
@@ -61,11 +94,26 @@ void Model::configure()
     std::string stepStr = Configured::getConfiguration(keyMap.at(TIMESTEP_KEY), std::string());
 
     iterator.parseAndSet(startTimeStr, stopTimeStr, durationStr, stepStr);
+}
+
+void Model::configure()
+{
+    std::string logLevel
+        = Configured::getConfiguration(keyMap.at(LOGLEVEL_KEY), std::string("info"));
+    setMinimumLevel(levelFromString(logLevel));
+
+    configureTime();
 
     initialFileName = Configured::getConfiguration(keyMap.at(RESTARTFILE_KEY), std::string());
 
     modelStep.setInitFile(initialFileName);
 
+    // Check the prognostic fields after each step, stopping at the first failure
+    if (Configured::getConfiguration(keyMap.at(HEALTHCHECK_KEY), false)) {
+        modelStep.setHealthCheck(Configured::getConfiguration(
+            keyMap.at(HEALTHCHECKCOLUMNS_KEY), HealthCheck::defaultMaxColumns));
+    }
+
     // Currently, initialize the data here in Model and pass the pointer to the
     // data structure to IModelStep
     dataStructure = StructureFactory::generateFromFile(initialFileName);
@@ -74,15 +122,139 @@ void Model::configure()
 
     // TODO Real external data handling (in the model step?)
     DummyExternalData::setAll(*dataStructure);
+
+    traceFileName = Configured::getConfiguration(keyMap.at(TRACEFILE_KEY), std::string());
+    if (!traceFileName.empty()) {
+        Timer::enableTracing(
+            Configured::getConfiguration(keyMap.at(TRACEEVENTS_KEY), defaultTraceEvents));
+    }
+
+    if (Configured::getConfiguration(keyMap.at(HWCOUNTERS_KEY), false)) {
+        if (!Timer::enableHardwareCounters(true)) {
+            warning("Hardware performance counters are not available");
+        }
+    }
+
+    if (Configured::getConfiguration(keyMap.at(ALLOCATIONS_KEY), false)) {
+        if (!Timer::enableAllocationCounting(true)) {
+            warning("Allocations are not counted, build with NEXTSIM_COUNT_ALLOCATIONS");
+        }
+    }
+
+    // Measure the peak rates of the machine, against which the timers report their work
+    if (Configured::getConfiguration(keyMap.at(ROOFLINE_KEY), false)) {
+        Roofline::measure();
+    }
+
+    timerReportFileName
+        = Configured::getConfiguration(keyMap.at(TIMERREPORT_KEY), std::string());
+
+    profileFileName = Configured::getConfiguration(keyMap.at(PROFILEFILE_KEY), std::string());
+    profileFrequency
+        = Configured::getConfiguration(keyMap.at(PROFILEFREQUENCY_KEY), Sampler::defaultFrequency);
+    profileSamples = Configured::getConfiguration(
+        keyMap.at(PROFILESAMPLES_KEY), static_cast<int>(Sampler::defaultSamples));
+
+    std::string metricsFileName
+        = Configured::getConfiguration(keyMap.at(METRICSFILE_KEY), std::string());
+    if (!metricsFileName.empty()) {
+        metricsFile.open(metricsFileName);
+        if (metricsFile.is_open()) {
+            telemetry.reset(new Telemetry(metricsFile,
+                Configured::getConfiguration(
+                    keyMap.at(METRICSINTERVAL_KEY), defaultMetricsInterval)));
+            iterator.setTelemetry(telemetry.get());
+        } else {
+            warning("Cannot open the metrics file " + metricsFileName + ", no metrics are written");
+        }
+    }
+}
+
+void Model::dryRun(std::ostream& os)
+{
+    configureTime();
+    initialFileName = Configured::getConfiguration(keyMap.at(RESTARTFILE_KEY), std::string());
+
+    CapacityPlan plan;
+    plan.configure();
+    plan.setRun(iterator.nSteps(), iterator.getTimestep());
+
+    // Only the structure type and the size of the grid are read from the restart file
+    std::shared_ptr<IStructure> structure = StructureFactory::generateFromFile(initialFileName);
+    std::shared_ptr<DevGrid> grid = std::dynamic_pointer_cast<DevGrid>(structure);
+    if (!grid)
+        throw std::invalid_argument(
+            "Model::dryRun: the size of a " + structure->structureType() + " is not known");
+    const int nLayers = grid->initSize(initialFileName);
+    plan.setGrid(structure->structureType(), grid->nx(), grid->ny(), nLayers);
+
+    ModuleLoader& loader = ModuleLoader::getLoader();
+    std::map<std::string, std::string> implementations;
+    for (const std::string& module : loader.listModules()) {
+        implementations[module] = loader.getImplementationName(module);
+    }
+    plan.setModules(implementations);
+
+    plan.report(os);
 }
 
-void Model::run() { iterator.run(); }
+bool Model::run()
+{
+    ScopedTimer::setTimerAddress(&Timer::main);
+    if (!profileFileName.empty() && !Sampler::start(profileFrequency, profileSamples)) {
+        warning("Sampling profiler is not available");
+    }
+    try {
+        ScopedTimer runTimer("run");
+        iterator.run();
+    } catch (std::runtime_error& e) {
+        if (!modelStep.getHealthCheck().failed())
+            throw;
+        // Log the report of the failing columns a line at a time, as each
+        // message holds a limited amount of text
+        std::stringstream report(e.what());
+        std::string line;
+        while (std::getline(report, line)) {
+            critical(line);
+        }
+        // Do not overwrite a restart file with the failed state
+        writeRestart = false;
+    }
+
+    if (Sampler::isRunning()) {
+        Sampler::stop();
+        if (Sampler::dropped() > 0)
+            warning("The sampling profiler dropped " + std::to_string(Sampler::dropped())
+                + " samples, increase model.profile_samples to keep them");
+        std::ofstream profileFile(profileFileName);
+        Sampler::writeFolded(profileFile);
+    }
+
+    if (!traceFileName.empty()) {
+        std::ofstream traceFile(traceFileName);
+        Timer::writeTrace(traceFile);
+    }
+
+    if (!timerReportFileName.empty()) {
+        Timer::main.mergeThreadTimers();
+        std::ofstream reportFile(timerReportFileName);
+        const std::string jsonExtension = ".json";
+        if (timerReportFileName.size() >= jsonExtension.size()
+            && timerReportFileName.compare(timerReportFileName.size() - jsonExtension.size(),
+                   jsonExtension.size(), jsonExtension)
+                == 0) {
+            Timer::main.reportJSON(reportFile);
+        } else {
+            Timer::main.reportCSV(reportFile);
+        }
+    }
+    return writeRestart;
+}
 
 void Model::writeRestartFile()
 {
     if (dataStructure) {
-        // TODO Replace with real logging
-        std::cout << "  Writing restart file: " << finalFileName << std::endl;
+        info("Writing restart file: ", finalFileName);
         dataStructure->dump(finalFileName);
     }
 }
@@ -46,6 +46,9 @@ void ModuleLoader::init(const VariablesMap& map)
 void ModuleLoader::setImplementation(const std::string& module, const std::string& impl)
 {
 #include "moduleLoaderAssignments.ipp"
+    // Unknown modules are ignored by the assignments
+    if (m_modules.count(module))
+        m_implementationNames[module] = impl;
 }
 
 void ModuleLoader::setDefault(const std::string& module)
@@ -0,0 +1,115 @@
+/*!
+ * @file PerfCounters.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace Nextsim {
+
+#ifdef __linux__
+static const uint64_t eventConfig[PerfCounters::N_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+static int openEvent(uint64_t config, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (groupFd < 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // The times enabled and running show whether the kernel multiplexed the
+    // counters with other events
+    attr.read_format
+        = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // This thread, on any CPU
+    return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+
+PerfCounters::PerfCounters()
+    : m_groupFd(-1)
+    , m_nOpen(0)
+{
+    m_fd.fill(-1);
+    m_slot.fill(-1);
+#ifdef __linux__
+    for (int i = 0; i < N_COUNTERS; ++i) {
+        m_fd[i] = openEvent(eventConfig[i], m_groupFd);
+        if (m_fd[i] < 0)
+            continue;
+        if (m_groupFd < 0)
+            m_groupFd = m_fd[i];
+        m_slot[i] = m_nOpen++;
+    }
+    if (m_groupFd >= 0) {
+        ioctl(m_groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (int fd : m_fd) {
+        if (fd >= 0)
+            close(fd);
+    }
+#endif
+}
+
+void PerfCounters::read(Values& values) const
+{
+    values.fill(0);
+#ifdef __linux__
+    if (m_groupFd < 0)
+        return;
+    // The group read format is the number of counters, the times the group
+    // was enabled and running, and the values of the counters
+    uint64_t buffer[3 + N_COUNTERS];
+    if (::read(m_groupFd, buffer, sizeof(buffer)) <= 0)
+        return;
+    const uint64_t enabled = buffer[1];
+    const uint64_t running = buffer[2];
+    if (running == 0)
+        return;
+    // A multiplexed group only counted while it was running, so its counts
+    // are scaled up to the whole time it was enabled
+    const double scale = (running < enabled) ? static_cast<double>(enabled) / running : 1;
+    for (int i = 0; i < N_COUNTERS; ++i) {
+        if (m_slot[i] >= 0)
+            values[i] = static_cast<uint64_t>(buffer[3 + m_slot[i]] * scale);
+    }
+#endif
+}
+
+const char* PerfCounters::name(Counter counter)
+{
+    static const char* names[N_COUNTERS] = {
+        "cycles",
+        "instructions",
+        "LLC misses",
+        "branch misses",
+    };
+    return names[counter];
+}
+
+} /* namespace Nextsim */
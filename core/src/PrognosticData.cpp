@@ -11,6 +11,7 @@ namespace Nextsim {
 
 double PrognosticData::m_dt = 0;
 IFreezingPoint* PrognosticData::m_freezer = nullptr;
+unsigned int PrognosticData::s_freezerGeneration = 1;
 
 PrognosticData::PrognosticData()
     : PrognosticData(1)
@@ -24,6 +25,8 @@ PrognosticData::PrognosticData(int nIceLayers)
     , m_sst(0)
     , m_thick(0)
     , m_tice(nIceLayers, 0.)
+    , m_tf(0)
+    , m_cacheGeneration(0)
 {
     //    m_tice.resize(nIceLayers);
 }
@@ -35,6 +38,8 @@ PrognosticData::PrognosticData(const PrognosticGenerator& up)
     , m_tice()
     , m_sst(up.seaSurfaceTemperature())
     , m_sss(up.seaSurfaceSalinity())
+    , m_tf(0)
+    , m_cacheGeneration(0)
 {
     m_tice = up.updatedIceTemperatures();
 }
@@ -49,6 +54,8 @@ PrognosticData& PrognosticData::operator=(const PrognosticGenerator& up)
 
     m_sst = up.seaSurfaceTemperature();
     m_sss = up.seaSurfaceSalinity();
+    // The salinity has changed
+    m_cacheGeneration = 0;
 
     return *this;
 }
@@ -58,6 +65,8 @@ void PrognosticData::configure()
     ModuleLoader& loader = ModuleLoader::getLoader();
     m_freezer = &loader.getImplementation<IFreezingPoint>();
     tryConfigure(m_freezer);
+    // Invalidate the derived quantities cached by all elements
+    ++s_freezerGeneration;
 }
 
 PrognosticData& PrognosticData::updateAndIntegrate(const IPrognosticUpdater& updater)
@@ -74,6 +83,7 @@ PrognosticData& PrognosticData::setSeaSurface(double sst, double sss)
 {
     m_sst = sst;
     m_sss = sss;
+    m_cacheGeneration = 0;
     return *this;
 }
 
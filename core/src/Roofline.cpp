@@ -0,0 +1,84 @@
+/*!
+ * @file Roofline.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/Roofline.hpp"
+
+#include "include/Timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace Nextsim {
+
+// Returns the seconds taken by a call to the function
+template <typename F> static double secondsFor(F function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Keeps the results of the probes from being optimized away
+static volatile double sink;
+
+double Roofline::bandwidth(size_t arraySize, int repeats)
+{
+    std::vector<double> a(arraySize, 0.);
+    std::vector<double> b(arraySize, 1.);
+    std::vector<double> c(arraySize, 2.);
+    const double scalar = 3.;
+
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < repeats; ++r) {
+        best = std::min(best, secondsFor([&]() {
+            for (size_t i = 0; i < arraySize; ++i) {
+                a[i] = b[i] + scalar * c[i];
+            }
+        }));
+    }
+    sink = a[arraySize / 2];
+    // Two arrays read and one written
+    const double bytes = 3. * sizeof(double) * arraySize;
+    return (best > 0) ? bytes / best : 0;
+}
+
+double Roofline::flopRate(long iterations, int repeats)
+{
+    // Independent chains, to hide the latency of each multiply-add
+    const int nChains = 8;
+    static volatile double seed = 1.;
+    const double multiplier = 1. - 1e-9;
+    const double addend = 1e-9;
+
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < repeats; ++r) {
+        double chains[nChains];
+        for (int c = 0; c < nChains; ++c) {
+            chains[c] = seed + c;
+        }
+        best = std::min(best, secondsFor([&]() {
+            for (long i = 0; i < iterations; ++i) {
+                for (int c = 0; c < nChains; ++c) {
+                    chains[c] = chains[c] * multiplier + addend;
+                }
+            }
+        }));
+        double sum = 0;
+        for (int c = 0; c < nChains; ++c) {
+            sum += chains[c];
+        }
+        sink = sum;
+    }
+    // One multiply and one add per chain per iteration
+    const double flops = 2. * nChains * iterations;
+    return (best > 0) ? flops / best : 0;
+}
+
+void Roofline::measure(size_t arraySize) { Timer::setPeak(bandwidth(arraySize), flopRate()); }
+
+} /* namespace Nextsim */
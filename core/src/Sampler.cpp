@@ -0,0 +1,291 @@
+/*!
+ * @file Sampler.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/Sampler.hpp"
+
+#include "include/ScopedTimer.hpp"
+#include "include/Timer.hpp"
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+namespace {
+
+struct StackSample {
+    int timerDepth;
+    Timer::Id timerPath[Sampler::maxTimerDepth];
+    int nFrames;
+    void* frames[Sampler::maxFrames];
+};
+
+struct ThreadSamples {
+    // Mapped by the owning thread when it claims the buffer
+    StackSample* samples;
+    size_t capacity;
+    // Written only by the owning thread, within the signal handler
+    size_t count;
+    size_t dropped;
+};
+
+struct SamplerState {
+    std::vector<ThreadSamples> buffers;
+    size_t samplesPerThread;
+    std::atomic<int> claimed;
+    // Distinguishes the buffers of successive starts
+    std::atomic<int> generation;
+    std::atomic<bool> running;
+    // Samples of threads which could not claim a buffer
+    std::atomic<size_t> unbuffered;
+};
+
+SamplerState& state()
+{
+    static SamplerState samplerState;
+    return samplerState;
+}
+
+// Constant initialized, so safe to use within the signal handler
+thread_local ThreadSamples* p_threadSamples = nullptr;
+thread_local int threadGeneration = 0;
+
+/*
+ * Returns the buffer of the calling thread, claiming one if this is its first
+ * sample since the start. The samples of a newly claimed buffer are mapped
+ * directly from the kernel, as malloc() cannot be called within the signal
+ * handler, and only the pages that are written to are then backed by memory.
+ */
+ThreadSamples* threadSamples(SamplerState& st)
+{
+    const int generation = st.generation.load(std::memory_order_relaxed);
+    if (threadGeneration != generation) {
+        const int index = st.claimed.fetch_add(1, std::memory_order_relaxed);
+        p_threadSamples = (index < Sampler::maxThreads) ? &st.buffers[index] : nullptr;
+        threadGeneration = generation;
+#ifdef __linux__
+        if (p_threadSamples) {
+            void* samples = mmap(nullptr, st.samplesPerThread * sizeof(StackSample),
+                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (samples != MAP_FAILED) {
+                p_threadSamples->samples = static_cast<StackSample*>(samples);
+                p_threadSamples->capacity = st.samplesPerThread;
+            }
+        }
+#endif
+    }
+    return p_threadSamples;
+}
+} /* anonymous namespace */
+
+#ifdef __linux__
+// The signal handler and the trampoline that calls it
+static const int skippedFrames = 2;
+
+void sampleHandler(int)
+{
+    const int savedErrno = errno;
+    SamplerState& st = state();
+    if (st.running.load(std::memory_order_relaxed)) {
+        ThreadSamples* buffer = threadSamples(st);
+        if (!buffer) {
+            st.unbuffered.fetch_add(1, std::memory_order_relaxed);
+        } else if (buffer->count == buffer->capacity) {
+            ++buffer->dropped;
+        } else {
+            StackSample& sample = buffer->samples[buffer->count];
+            sample.timerDepth = Sampler::runningTimerPath(sample.timerPath);
+            void* frames[Sampler::maxFrames + skippedFrames];
+            const int nFrames = backtrace(frames, Sampler::maxFrames + skippedFrames);
+            sample.nFrames = std::max(nFrames - skippedFrames, 0);
+            std::copy(frames + skippedFrames, frames + skippedFrames + sample.nFrames,
+                sample.frames);
+            std::atomic_signal_fence(std::memory_order_release);
+            ++buffer->count;
+        }
+    }
+    errno = savedErrno;
+}
+
+static bool setTimer(int frequency)
+{
+    itimerval interval;
+    interval.it_interval.tv_sec = 0;
+    interval.it_interval.tv_usec = (frequency > 0) ? std::max(1000000 / frequency, 1) : 0;
+    interval.it_value = interval.it_interval;
+    return setitimer(ITIMER_PROF, &interval, nullptr) == 0;
+}
+
+// Returns the name of the function containing an address, or its offset in the object file
+static std::string symbolName(void* address)
+{
+    Dl_info info;
+    if (dladdr(address, &info) == 0) {
+        std::stringstream hex;
+        hex << address;
+        return hex.str();
+    }
+    if (info.dli_sname) {
+        int status;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = (status == 0) ? demangled : info.dli_sname;
+        std::free(demangled);
+        // Drop the parameter list
+        size_t paren = name.find('(');
+        return (paren == std::string::npos || paren == 0) ? name : name.substr(0, paren);
+    }
+    std::string object = info.dli_fname ? info.dli_fname : "";
+    object = object.substr(object.find_last_of('/') + 1);
+    std::stringstream offset;
+    offset << object << "+0x" << std::hex
+           << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    return offset.str();
+}
+#endif
+
+int Sampler::runningTimerPath(Timer::Id* path)
+{
+    const Timer* timer = ScopedTimer::timerAddress();
+    if (!timer || timer->restructuring)
+        return 0;
+    // Walk up from the running timer, then reverse to start at the root
+    int depth = 0;
+    for (int node = timer->current; node >= 0 && depth < maxTimerDepth;
+         node = timer->nodes[node].parent) {
+        path[depth++] = timer->nodes[node].id;
+    }
+    std::reverse(path, path + depth);
+    return depth;
+}
+
+bool Sampler::start(int frequency, size_t samplesPerThread)
+{
+#ifdef __linux__
+    if (frequency <= 0 || samplesPerThread == 0)
+        return false;
+    stop();
+    SamplerState& st = state();
+    // Unmap the samples of the previous start
+    st.buffers.resize(maxThreads);
+    for (auto& buffer : st.buffers) {
+        if (buffer.samples)
+            munmap(buffer.samples, buffer.capacity * sizeof(StackSample));
+        buffer.samples = nullptr;
+        buffer.capacity = 0;
+        buffer.count = 0;
+        buffer.dropped = 0;
+    }
+    st.samplesPerThread = samplesPerThread;
+    st.claimed = 0;
+    st.unbuffered = 0;
+    ++st.generation;
+
+    // The first call to backtrace() may load libgcc, which is not safe within the handler
+    void* frames[maxFrames];
+    backtrace(frames, maxFrames);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = sampleHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0)
+        return false;
+
+    st.running = true;
+    if (!setTimer(frequency)) {
+        st.running = false;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Sampler::stop()
+{
+#ifdef __linux__
+    SamplerState& st = state();
+    if (!st.running)
+        return;
+    setTimer(0);
+    st.running = false;
+#endif
+}
+
+bool Sampler::isRunning() { return state().running; }
+
+size_t Sampler::samples()
+{
+    size_t total = 0;
+    for (auto& buffer : state().buffers) {
+        total += buffer.count;
+    }
+    return total;
+}
+
+size_t Sampler::dropped()
+{
+    size_t total = state().unbuffered;
+    for (auto& buffer : state().buffers) {
+        total += buffer.dropped;
+    }
+    return total;
+}
+
+std::ostream& Sampler::writeFolded(std::ostream& os)
+{
+#ifdef __linux__
+    // Count the samples of each distinct stack, in lexical order
+    std::map<std::string, size_t> stacks;
+    std::map<void*, std::string> symbols;
+    for (auto& buffer : state().buffers) {
+        for (size_t i = 0; i < buffer.count; ++i) {
+            const StackSample& sample = buffer.samples[i];
+            std::string stack;
+            for (int t = 0; t < sample.timerDepth; ++t) {
+                std::string timerName = Timer::name(sample.timerPath[t]);
+                std::replace(timerName.begin(), timerName.end(), ';', ',');
+                stack += (t > 0 ? ";" : "") + timerName;
+            }
+            if (sample.timerDepth == 0)
+                stack = "[untimed]";
+            for (int f = sample.nFrames - 1; f >= 0; --f) {
+                void* address = sample.frames[f];
+                auto found = symbols.find(address);
+                if (found == symbols.end())
+                    found = symbols.insert(std::make_pair(address, symbolName(address))).first;
+                stack += ";" + found->second;
+            }
+            ++stacks[stack];
+        }
+    }
+    for (auto& stack : stacks) {
+        os << stack.first << " " << stack.second << std::endl;
+    }
+#endif
+    return os;
+}
+
+} /* namespace Nextsim */
@@ -8,14 +8,14 @@
 #include "include/ScopedTimer.hpp"
 
 namespace Nextsim {
-Timer* ScopedTimer::p_timer;
+thread_local Timer* ScopedTimer::p_timer = nullptr;
 
 ScopedTimer::ScopedTimer()
     : ScopedTimer("")
 {
 }
 
-ScopedTimer::ScopedTimer(const std::string& name) { p_timer->tick(name); }
+ScopedTimer::ScopedTimer(const std::string& name) { timer().tick(name); }
 
 ScopedTimer::~ScopedTimer() { p_timer->tock(); }
 
@@ -26,6 +26,4 @@ void ScopedTimer::substitute(const std::string& newName)
 }
 
 void ScopedTimer::setTimerAddress(Timer* timer) { p_timer = timer; }
-
-Timer& ScopedTimer::timer() { return *p_timer; }
 }
@@ -7,7 +7,6 @@
 #include "include/SimpleIterant.hpp"
 
 #include <ctime>
-#include <iostream>
 #include <sstream>
 #include <string>
 
@@ -18,28 +17,32 @@ SimpleIterant::SimpleIterant()
     // It's so simple, there's nothing here
 }
 
-void SimpleIterant::init() { std::cout << "SimpleIterant::init" << std::endl; }
+void SimpleIterant::init() { info("SimpleIterant::init"); }
 
 void SimpleIterant::start(const Iterator::TimePoint& startTime)
 {
-    std::cout << "SimpleIterant::start at " << stringFromTimePoint(startTime) << std::endl;
+    info("SimpleIterant::start at ", stringFromTimePoint(startTime));
 }
 
 void SimpleIterant::iterate(const Iterator::Duration& dt)
 {
-    std::cout << "SimpleIterant::iterate for " << count(dt) << std::endl;
+    debug("SimpleIterant::iterate for ", count(dt));
 }
 
 void SimpleIterant::stop(const Iterator::TimePoint& stopTime)
 {
-    std::cout << "SimpleIterant::stop at " << stringFromTimePoint(stopTime) << std::endl;
+    info("SimpleIterant::stop at ", stringFromTimePoint(stopTime));
 }
 
 std::string SimpleIterant::stringFromTimePoint(
     const std::chrono::time_point<std::chrono::system_clock>& t)
 {
     std::time_t t_c = Nextsim::Iterator::Clock::to_time_t(t);
-    return std::string(ctime(&t_c));
+    std::string timeString(ctime(&t_c));
+    // Without the newline that ctime ends with
+    if (!timeString.empty() && timeString.back() == '\n')
+        timeString.pop_back();
+    return timeString;
 }
 
 std::string SimpleIterant::stringFromTimePoint(const int t)
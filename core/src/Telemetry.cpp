@@ -0,0 +1,132 @@
+/*!
+ * @file Telemetry.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/Telemetry.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+static const double daysPerYear = 365;
+
+// Writes a number as JSON, which has no representation of infinities or NaN
+static std::ostream& jsonNumber(std::ostream& os, double value)
+{
+    if (std::isfinite(value))
+        os << value;
+    else
+        os << "null";
+    return os;
+}
+
+// Returns a string with the characters that cannot appear in a JSON string escaped
+static std::string jsonString(const std::string& text)
+{
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            escaped += c;
+    }
+    return escaped;
+}
+
+Telemetry::Telemetry(std::ostream& os, int interval, const Timer& timer)
+    : m_os(os)
+    , m_interval(interval)
+    , m_timer(timer)
+    , m_stepTimer("DevStep")
+    , m_columnTimer("column physics")
+    , m_stopTime(0)
+    , m_steps(0)
+{
+}
+
+void Telemetry::start(TimePoint startTime, TimePoint stopTime)
+{
+    m_stopTime = stopTime;
+    m_steps = 0;
+    m_start = measure(startTime);
+    m_previous = m_start;
+}
+
+void Telemetry::step(TimePoint modelTime)
+{
+    ++m_steps;
+    if (m_interval > 0 && m_steps % m_interval == 0) {
+        Sample now = measure(modelTime);
+        write(now, m_previous, false);
+        m_previous = now;
+    }
+}
+
+void Telemetry::finish(TimePoint modelTime) { write(measure(modelTime), m_start, true); }
+
+Telemetry::Sample Telemetry::measure(TimePoint modelTime) const
+{
+    Sample sample;
+    sample.wall = std::chrono::steady_clock::now();
+    sample.modelTime = modelTime;
+    sample.steps = m_steps;
+    // The timers do not exist until they are first started
+    try {
+        sample.columns = m_timer.items(m_columnTimer);
+    } catch (const std::out_of_range&) {
+        sample.columns = 0;
+    }
+    try {
+        for (const Timer::Key& phase : m_timer.children(m_stepTimer)) {
+            sample.phases[phase] = m_timer.elapsed(phase);
+        }
+    } catch (const std::out_of_range&) {
+    }
+    return sample;
+}
+
+void Telemetry::write(const Sample& now, const Sample& since, bool final)
+{
+    const double runWall = std::chrono::duration<double>(now.wall - m_start.wall).count();
+    const double wall = std::chrono::duration<double>(now.wall - since.wall).count();
+    // Model seconds per wall second, which is also simulated days per wall day
+    const double modelRate = (now.modelTime - since.modelTime) / wall;
+
+    m_os << "{\"step\": " << now.steps << ", \"model_time\": " << now.modelTime;
+    m_os << ", \"wall_s\": ";
+    jsonNumber(m_os, runWall);
+    m_os << ", \"interval_s\": ";
+    jsonNumber(m_os, wall);
+    m_os << ", \"sim_days_per_day\": ";
+    jsonNumber(m_os, modelRate);
+    m_os << ", \"sypd\": ";
+    jsonNumber(m_os, modelRate / daysPerYear);
+    m_os << ", \"columns_per_s\": ";
+    jsonNumber(m_os, (now.columns - since.columns) / wall);
+
+    m_os << ", \"phase_share\": {";
+    double phaseTotal = 0;
+    for (auto& phase : now.phases) {
+        auto previous = since.phases.find(phase.first);
+        double phaseTime = phase.second;
+        if (previous != since.phases.end())
+            phaseTime -= previous->second;
+        phaseTotal += phaseTime;
+        m_os << "\"" << jsonString(phase.first) << "\": ";
+        jsonNumber(m_os, phaseTime / wall);
+        m_os << ", ";
+    }
+    m_os << "\"other\": ";
+    jsonNumber(m_os, (wall - phaseTotal) / wall);
+    m_os << "}";
+
+    m_os << ", \"eta_s\": ";
+    jsonNumber(m_os, (m_stopTime - now.modelTime) / modelRate);
+    m_os << ", \"final\": " << (final ? "true" : "false") << "}" << std::endl;
+}
+
+} /* namespace Nextsim */
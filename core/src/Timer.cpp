@@ -10,12 +10,107 @@
 #include "include/Chrono.hpp"
 #include <chrono>
 #include <ctime>
-#include <map>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 namespace Nextsim {
+
+inline double secondsFromWall(const Timer::WallTimeDuration& wall)
+{
+    return std::chrono::duration_cast<std::chrono::duration<double>>(wall).count();
+}
+
+// The interned timer names, shared by all Timers
+struct TimerNameRegistry {
+    std::mutex lock;
+    std::unordered_map<Timer::Key, Timer::Id> ids;
+    // A deque does not move its elements as it grows
+    std::deque<Timer::Key> names;
+};
+
+static TimerNameRegistry& nameRegistry()
+{
+    static TimerNameRegistry registry;
+    return registry;
+}
+
+// The calibrated overhead of a tick and tock pair
+struct TimerOverhead {
+    bool calibrated = false;
+    Timer::WallTimeDuration perPair = Timer::WallTimeDuration::zero();
+};
+
+static TimerOverhead& timerOverhead()
+{
+    static TimerOverhead overhead;
+    return overhead;
+}
+
+// The timers of all threads which have used Timer::threadTimer()
+struct ThreadTimerRegistry {
+    std::mutex lock;
+    std::vector<std::shared_ptr<Timer>> timers;
+};
+
+static ThreadTimerRegistry& threadTimerRegistry()
+{
+    static ThreadTimerRegistry registry;
+    return registry;
+}
+
+// The capacity and time origin of trace event recording
+struct TraceSettings {
+    size_t capacity = 0;
+    Timer::WallTimePoint epoch = std::chrono::steady_clock::now();
+};
+
+static TraceSettings& traceSettings()
+{
+    static TraceSettings settings;
+    return settings;
+}
+
+static bool& allocationCounting()
+{
+    static bool counting = false;
+    return counting;
+}
+
+// The peak rates of the machine, zero if unknown
+struct PeakRates {
+    double bytesPerSecond;
+    double flopsPerSecond;
+};
+
+static PeakRates& peakRates()
+{
+    static PeakRates rates = { 0, 0 };
+    return rates;
+}
+
+// Returns the ratio, or zero if the denominator is zero
+static double ratio(double numerator, double denominator)
+{
+    return (denominator != 0) ? numerator / denominator : 0;
+}
+
+static bool& hardwareCounting()
+{
+    static bool counting = false;
+    return counting;
+}
+
 // Static main clock
 Timer Timer::main("main");
 
@@ -25,70 +120,151 @@ Timer::Timer()
 }
 
 Timer::Timer(const Key& baseTimerName)
-    : root()
-    , current(&root)
+    : current(root)
+    , restructuring(0)
+    , countingAllocations(false)
+    , traceNext(0)
+    , traceWrapped(false)
+{
+    nodes.push_back(TimerNode(id(baseTimerName), -1));
+    nodes[root].timeKeeper.start();
+}
+
+Timer::Id Timer::id(const Key& timerName)
+{
+    TimerNameRegistry& registry = nameRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    auto found = registry.ids.find(timerName);
+    if (found != registry.ids.end())
+        return found->second;
+    Id newId = registry.names.size();
+    registry.names.push_back(timerName);
+    registry.ids[timerName] = newId;
+    return newId;
+}
+
+bool Timer::findId(const Key& timerName, Id& timerId)
+{
+    TimerNameRegistry& registry = nameRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    auto found = registry.ids.find(timerName);
+    if (found == registry.ids.end())
+        return false;
+    timerId = found->second;
+    return true;
+}
+
+const Timer::Key& Timer::name(Id timerId)
+{
+    TimerNameRegistry& registry = nameRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    return registry.names.at(timerId);
+}
+
+int Timer::addNode(int parentIndex, Id childId)
 {
-    root.name = baseTimerName;
-    root.tick();
+    restructuring = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    int index = nodes.size();
+    nodes.push_back(TimerNode(childId, parentIndex));
+    nodes[parentIndex].childNodes.push_back(std::make_pair(childId, index));
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    restructuring = 0;
+    return index;
 }
 
-void Timer::tick(const Timer::Key& timerName)
+double Timer::lap(const Key& timerName) const
 {
-    // Descend to the next child node, creating it if necessary
-    TimerNode* parent = current;
-    current = &current->childNodes[timerName];
-    // redundant assignment, except when a new node has been created above.
-    current->name = timerName;
-    current->parent = parent;
+    int node = findNode(timerName);
+    if (node < 0)
+        throw std::out_of_range("Timer::lap: no timer " + timerName);
+    const Chrono& timeKeeper = nodes[node].timeKeeper;
+    if (!timeKeeper.running())
+        return 0;
+    return secondsFromWall(std::chrono::steady_clock::now() - timeKeeper.wallHack());
+}
 
-    // Mark the time, ticks and run status of the node
-    current->tick();
+double Timer::elapsed(const Key& timerName) const
+{
+    int node = findNode(timerName);
+    if (node < 0)
+        throw std::out_of_range("Timer::elapsed: no timer " + timerName);
+    return secondsFromWall(nodes[node].timeKeeper.wallTime());
 }
 
-void Timer::tock(const std::string& timerName) { tock(); }
+long Timer::items(const Key& timerName) const
+{
+    int node = findNode(timerName);
+    if (node < 0)
+        throw std::out_of_range("Timer::items: no timer " + timerName);
+    return nodes[node].items;
+}
 
-void Timer::tock()
+std::vector<Timer::Key> Timer::children(const Key& timerName) const
 {
-    // Calculate the durations and stop running
-    current->tock();
-    // Ascend to the parent
-    current = current->parent;
+    int node = findNode(timerName);
+    if (node < 0)
+        throw std::out_of_range("Timer::children: no timer " + timerName);
+    std::vector<Key> childNames;
+    for (auto& child : nodes[node].childNodes) {
+        childNames.push_back(name(child.first));
+    }
+    return childNames;
 }
 
-void Timer::TimerNode::tick() { timeKeeper.start(); }
+int Timer::findNode(int node, Id timerId) const
+{
+    for (auto& child : nodes[node].childNodes) {
+        if (child.first == timerId)
+            return child.second;
+        int found = findNode(child.second, timerId);
+        if (found >= 0)
+            return found;
+    }
+    return -1;
+}
 
-void Timer::TimerNode::tock() { timeKeeper.stop(); }
-// TODO: implement lap and elapsed
-double Timer::lap(const Key& timerName) const { return 0; }
-double Timer::elapsed(const Key& timerName) const { return 0; }
+// Finds the first node of a timer name, without interning an unknown name
+int Timer::findNode(const Key& timerName) const
+{
+    Id timerId;
+    if (!findId(timerName, timerId))
+        return -1;
+    return findNode(root, timerId);
+}
 
 void Timer::additionalTime(
     const TimerPath& path, WallTimeDuration wallAdd, CpuTimeDuration cpuAdd, int ticksAdd)
 {
-    // Descend the given path
-    TimerNode& cursor = root;
+    // Descend the given path, creating any missing nodes
+    int cursor = root;
     for (auto& nodeName : path) {
-        cursor = cursor.childNodes[nodeName];
+        cursor = childNode(cursor, id(nodeName));
     }
-    cursor.timeKeeper.extraWallTime(wallAdd);
-    cursor.timeKeeper.extraCpuTime(cpuAdd);
-    cursor.timeKeeper.extraTicks(ticksAdd);
+    Chrono& timeKeeper = nodes[cursor].timeKeeper;
+    timeKeeper.extraWallTime(wallAdd);
+    timeKeeper.extraCpuTime(cpuAdd);
+    timeKeeper.extraTicks(ticksAdd);
 }
 
 Timer::TimerPath Timer::currentTimerNodePath() const
 {
     TimerPath path;
-    TimerNode* cursor = current;
-    while (cursor != &root) {
-        path.push_front(cursor->name);
-        cursor = cursor->parent;
+    int cursor = current;
+    while (cursor != root) {
+        path.push_front(name(nodes[cursor].id));
+        cursor = nodes[cursor].parent;
     }
     return path;
 }
 
 Timer::TimerPath Timer::pathToFirstMatch(const Key& timerName) const
 {
-    return root.searchDescendants(timerName);
+    TimerPath path;
+    Id timerId;
+    if (findId(timerName, timerId))
+        searchDescendants(root, timerId, path);
+    return path;
 }
 
 std::ostream& Timer::report(const Key& timerName, std::ostream& os) const
@@ -96,81 +272,521 @@ std::ostream& Timer::report(const Key& timerName, std::ostream& os) const
     return report(pathToFirstMatch(timerName), os);
 }
 
-std::ostream& Timer::report(std::ostream& os) const { return root.reportAll(os, ""); }
+std::ostream& Timer::report(std::ostream& os) const { return reportAll(root, os, ""); }
 
 std::ostream& Timer::report(const TimerPath& path, std::ostream& os) const
 {
-    const TimerNode* cursor = &root;
+    int cursor = root;
     for (auto& element : path) {
-        cursor = &cursor->childNodes.at(element);
+        Id elementId;
+        int next = -1;
+        if (findId(element, elementId)) {
+            for (auto& child : nodes[cursor].childNodes) {
+                if (child.first == elementId)
+                    next = child.second;
+            }
+        }
+        if (next < 0)
+            throw std::out_of_range("Timer::report: no timer " + element);
+        cursor = next;
     }
-    return cursor->report(os, "");
+    return report(cursor, os, "");
 }
 
 void Timer::reset()
 {
-    root.childNodes.clear();
-    root.timeKeeper.reset();
-    current = &root;
-    root.tick();
+    // Keep the allocated capacity, so that restarted timing does not allocate
+    restructuring = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    current = root;
+    nodes.erase(nodes.begin() + 1, nodes.end());
+    nodes[root].childNodes.clear();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    restructuring = 0;
+    nodes[root].timeKeeper.reset();
+    nodes[root].timeKeeper.start();
 }
 
-Timer::TimerNode::TimerNode()
-    : parent(nullptr)
+Timer& Timer::threadTimer()
 {
+    thread_local std::shared_ptr<Timer> timer;
+    if (!timer) {
+        timer = std::make_shared<Timer>("thread");
+        timer->setTraceCapacity(traceSettings().capacity);
+        if (hardwareCounting())
+            timer->perfCounters.reset(new PerfCounters());
+        timer->countingAllocations = allocationCounting();
+        ThreadTimerRegistry& registry = threadTimerRegistry();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        registry.timers.push_back(timer);
+    }
+    return *timer;
 }
 
-Timer::TimerPath Timer::TimerNode::searchDescendants(const Key& timerName) const
+void Timer::mergeThreadTimers()
 {
-    TimerPath path;
-    for (auto& children : childNodes) {
-        if (children.first == timerName) {
-            path.push_front(children.first);
-        } else if (!children.second.searchDescendants(timerName).empty()) {
-            path.push_front(name);
+    ThreadTimerRegistry& registry = threadTimerRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for (auto& timer : registry.timers) {
+        for (auto& child : timer->nodes[root].childNodes) {
+            mergeNode(current, *timer, child.second);
         }
+        timer->reset();
     }
-    return path;
+    // Forget the timers of threads which have finished, unless they hold trace events
+    registry.timers.erase(std::remove_if(registry.timers.begin(), registry.timers.end(),
+                              [](const std::shared_ptr<Timer>& timer) {
+                                  return timer.unique() && timer->traceEvents.empty();
+                              }),
+        registry.timers.end());
+}
+
+void Timer::mergeNode(int targetParent, Timer& source, int sourceNode)
+{
+    const TimerNode& from = source.nodes[sourceNode];
+    const int target = childNode(targetParent, from.id);
+    const WallTimeDuration wallTime = from.timeKeeper.wallTime();
+
+    TimerNode& to = nodes[target];
+    to.timeKeeper.extraWallTime(wallTime);
+    to.timeKeeper.extraCpuTime(from.timeKeeper.cpuTime());
+    to.timeKeeper.extraTicks(from.timeKeeper.ticks());
+    for (int i = 0; i < PerfCounters::N_COUNTERS; ++i) {
+        to.counters[i] += from.counters[i];
+    }
+    to.items += from.items;
+    to.bytes += from.bytes;
+    to.flops += from.flops;
+    to.allocations.allocations += from.allocations.allocations;
+    to.allocations.bytes += from.allocations.bytes;
+    to.peakResident = std::max(to.peakResident, from.peakResident);
+
+    to.threadMin = (to.threadCount > 0) ? std::min(to.threadMin, wallTime) : wallTime;
+    to.threadMax = (to.threadCount > 0) ? std::max(to.threadMax, wallTime) : wallTime;
+    to.threadSum += wallTime;
+    ++to.threadCount;
+
+    for (auto& child : from.childNodes) {
+        mergeNode(target, source, child.second);
+    }
+}
+
+void Timer::setPeak(double bytesPerSecond, double flopsPerSecond)
+{
+    peakRates() = PeakRates { bytesPerSecond, flopsPerSecond };
+}
+
+bool Timer::enableHardwareCounters(bool enable)
+{
+    hardwareCounting() = enable;
+    main.perfCounters.reset(enable ? new PerfCounters() : nullptr);
+    return enable && main.perfCounters->available();
+}
+
+void Timer::accumulateCounters(TimerNode& node)
+{
+    PerfCounters::Values now;
+    perfCounters->read(now);
+    for (int i = 0; i < PerfCounters::N_COUNTERS; ++i) {
+        // The scaled counts of multiplexed counters are estimates, which can
+        // decrease between two reads
+        if (now[i] > node.countersAtStart[i])
+            node.counters[i] += now[i] - node.countersAtStart[i];
+    }
+}
+
+bool Timer::enableAllocationCounting(bool enable)
+{
+    allocationCounting() = enable;
+    main.countingAllocations = enable;
+    return enable && AllocationCounter::installed();
+}
+
+void Timer::accumulateAllocations(TimerNode& node)
+{
+    const AllocationCounter::Counts& now = AllocationCounter::threadCounts();
+    node.allocations.allocations += now.allocations - node.allocationsAtStart.allocations;
+    node.allocations.bytes += now.bytes - node.allocationsAtStart.bytes;
+    node.peakResident = std::max(node.peakResident, peakResidentSize());
+}
+
+long Timer::peakResidentSize()
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    // Reported in bytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+void Timer::enableTracing(size_t eventsPerTimer)
+{
+    TraceSettings& settings = traceSettings();
+    settings.capacity = eventsPerTimer;
+    settings.epoch = std::chrono::steady_clock::now();
+
+    main.setTraceCapacity(eventsPerTimer);
+    ThreadTimerRegistry& registry = threadTimerRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for (auto& timer : registry.timers) {
+        timer->setTraceCapacity(eventsPerTimer);
+    }
+}
+
+void Timer::setTraceCapacity(size_t capacity)
+{
+    traceEvents.assign(capacity, TraceEvent());
+    traceEvents.shrink_to_fit();
+    traceNext = 0;
+    traceWrapped = false;
+}
+
+std::ostream& Timer::writeTrace(std::ostream& os)
+{
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    main.writeTraceEvents(os, 0, first);
+    ThreadTimerRegistry& registry = threadTimerRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    int tid = 0;
+    for (auto& timer : registry.timers) {
+        timer->writeTraceEvents(os, ++tid, first);
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    return os;
+}
+
+// Escapes a string for use as a JSON string value
+static std::string jsonEscape(const std::string& str)
+{
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::ostream& Timer::writeTraceEvents(std::ostream& os, int tid, bool& first) const
+{
+    const size_t nEvents = traceWrapped ? traceEvents.size() : traceNext;
+    const size_t start = traceWrapped ? traceNext : 0;
+    const WallTimePoint epoch = traceSettings().epoch;
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    // Stop events whose start has been overwritten in the ring buffer are skipped
+    int depth = 0;
+    for (size_t i = 0; i < nEvents; ++i) {
+        const TraceEvent& event = traceEvents[(start + i) % traceEvents.size()];
+        if (event.begin) {
+            ++depth;
+        } else if (depth > 0) {
+            --depth;
+        } else {
+            continue;
+        }
+        double microseconds
+            = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+                event.time - epoch)
+                  .count();
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":\"" << jsonEscape(name(event.id)) << "\",\"ph\":\""
+           << (event.begin ? "B" : "E") << "\",\"ts\":" << microseconds
+           << ",\"pid\":0,\"tid\":" << tid << "}";
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+Timer::WallTimeDuration Timer::calibrate()
+{
+    const int nPairs = 100000;
+    Timer scratch("calibration");
+    const Id probe = id("calibration probe");
+    // Create the node before starting the measurement
+    scratch.tick(probe);
+    scratch.tock();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nPairs; ++i) {
+        scratch.tick(probe);
+        scratch.tock();
+    }
+    WallTimeDuration total = std::chrono::steady_clock::now() - start;
+
+    TimerOverhead& overhead = timerOverhead();
+    overhead.perPair = total / nPairs;
+    overhead.calibrated = true;
+    return overhead.perPair;
+}
+
+Timer::WallTimeDuration Timer::overhead()
+{
+    TimerOverhead& overhead = timerOverhead();
+    return overhead.calibrated ? overhead.perPair : calibrate();
+}
+
+Timer::TimerNode::TimerNode(Id nodeId, int parentIndex)
+    : id(nodeId)
+    , parent(parentIndex)
+    , items(0)
+    , bytes(0)
+    , flops(0)
+    , peakResident(0)
+    , threadCount(0)
+    , threadMin(WallTimeDuration::zero())
+    , threadMax(WallTimeDuration::zero())
+    , threadSum(WallTimeDuration::zero())
+{
+    countersAtStart.fill(0);
+    counters.fill(0);
+    allocationsAtStart = allocations = AllocationCounter::Counts { 0, 0 };
+}
+
+int Timer::descendantTicks(int node) const
+{
+    int ticks = 0;
+    for (auto& child : nodes[node].childNodes) {
+        ticks += nodes[child.second].timeKeeper.ticks() + descendantTicks(child.second);
+    }
+    return ticks;
+}
+
+Timer::WallTimeDuration Timer::correctedWallTime(int node) const
+{
+    WallTimeDuration wallTime
+        = nodes[node].timeKeeper.wallTime() - overhead() * descendantTicks(node);
+    return (wallTime > WallTimeDuration::zero()) ? wallTime : WallTimeDuration::zero();
 }
 
-inline int msCountFromWall(const Timer::WallTimeDuration& wall)
+bool Timer::searchDescendants(int node, Id timerId, TimerPath& path) const
 {
-    return std::chrono::duration_cast<std::chrono::microseconds>(wall).count();
+    for (auto& child : nodes[node].childNodes) {
+        if (child.first == timerId || searchDescendants(child.second, timerId, path)) {
+            path.push_front(name(child.first));
+            return true;
+        }
+    }
+    return false;
 }
 
-std::ostream& Timer::TimerNode::report(std::ostream& os, const std::string& prefix) const
+std::ostream& Timer::report(int node, std::ostream& os, const std::string& prefix) const
 {
     os << prefix;
+    const Chrono& timeKeeper = nodes[node].timeKeeper;
+    const int parent = nodes[node].parent;
     // Get the wall time in seconds
-    WallTimeDuration wallTimeNow = timeKeeper.wallTime();
+    double wallSeconds = secondsFromWall(correctedWallTime(node));
     CpuTimeDuration cpuTimeNow = timeKeeper.cpuTime();
 
     double pcParentWall;
     double pcParentCpu;
-    if (parent) {
-        WallTimeDuration wallTimeParent = parent->timeKeeper.wallTime();
-        CpuTimeDuration cpuTimeParent = parent->timeKeeper.cpuTime();
-        pcParentWall = msCountFromWall(wallTimeNow) * 100. / msCountFromWall(wallTimeParent);
-        pcParentCpu = cpuTimeNow * 100. / cpuTimeParent;
+    if (parent >= 0) {
+        pcParentWall = wallSeconds * 100. / secondsFromWall(correctedWallTime(parent));
+        pcParentCpu = cpuTimeNow * 100. / nodes[parent].timeKeeper.cpuTime();
     } else {
         pcParentWall = 100;
         pcParentCpu = 100;
     }
 
-    double wallSeconds = msCountFromWall(wallTimeNow) * 1e-6;
-
-    os << name << ": ticks = " << timeKeeper.ticks();
+    os << name(nodes[node].id) << ": ticks = " << timeKeeper.ticks();
     os << " wall time " << wallSeconds << " s"
        << " (" << pcParentWall << "% of parent)";
-    os << " cpu time " << cpuTimeNow << " s"
-       << " (" << pcParentCpu << "% of parent)";
+    if (Chrono::isSamplingCpuTime() || cpuTimeNow > 0) {
+        os << " cpu time " << cpuTimeNow << " s"
+           << " (" << pcParentCpu << "% of parent)";
+    }
     os << " " << timeKeeper.ticks() << " activations (" << 1e3 * wallSeconds / timeKeeper.ticks()
        << " ms per call)";
+    const TimerNode& timerNode = nodes[node];
+    const PerfCounters::Values& counters = timerNode.counters;
+    if (counters[PerfCounters::CYCLES] > 0 || counters[PerfCounters::INSTRUCTIONS] > 0) {
+        for (int i = 0; i < PerfCounters::N_COUNTERS; ++i) {
+            os << " " << PerfCounters::name(static_cast<PerfCounters::Counter>(i)) << " "
+               << counters[i];
+        }
+        if (counters[PerfCounters::CYCLES] > 0) {
+            os << " (IPC "
+               << static_cast<double>(counters[PerfCounters::INSTRUCTIONS])
+                    / counters[PerfCounters::CYCLES]
+               << ")";
+        }
+    }
+    if (timerNode.items > 0) {
+        os << " " << timerNode.items << " items";
+        if (counters[PerfCounters::CYCLES] > 0) {
+            os << " (" << static_cast<double>(counters[PerfCounters::CYCLES]) / timerNode.items
+               << " cycles, "
+               << static_cast<double>(counters[PerfCounters::LLC_MISSES]) / timerNode.items
+               << " LLC misses per item)";
+        }
+    }
+    if (timerNode.bytes > 0 || timerNode.flops > 0) {
+        const double wall = secondsFromWall(correctedWallTime(node));
+        const PeakRates& peak = peakRates();
+        os << " " << 1e-9 * ratio(timerNode.bytes, wall) << " GB/s";
+        if (peak.bytesPerSecond > 0)
+            os << " (" << 100 * ratio(timerNode.bytes, wall) / peak.bytesPerSecond << "% of peak)";
+        os << " " << 1e-9 * ratio(timerNode.flops, wall) << " GFLOP/s";
+        if (peak.flopsPerSecond > 0)
+            os << " (" << 100 * ratio(timerNode.flops, wall) / peak.flopsPerSecond << "% of peak)";
+    }
+    if (timerNode.peakResident > 0) {
+        os << " allocations " << timerNode.allocations.allocations << " ("
+           << timerNode.allocations.bytes << " bytes) peak RSS " << timerNode.peakResident
+           << " kB";
+    }
+    if (timerNode.threadCount > 0) {
+        os << " across " << timerNode.threadCount << " threads min "
+           << secondsFromWall(timerNode.threadMin) << " s max "
+           << secondsFromWall(timerNode.threadMax) << " s mean "
+           << secondsFromWall(timerNode.threadSum) / timerNode.threadCount << " s";
+    }
     if (timeKeeper.running())
         os << "(running)";
     return os;
 }
 
+const std::vector<std::string>& Timer::reportColumns()
+{
+    static const std::vector<std::string> columns = {
+        "ticks",
+        "wall_s",
+        "cpu_s",
+        "wall_per_call_s",
+        "percent_of_parent_wall",
+        "items",
+        "items_per_s",
+        "cycles",
+        "instructions",
+        "llc_misses",
+        "branch_misses",
+        "ipc",
+        "allocations",
+        "allocated_bytes",
+        "peak_rss_kB",
+        "threads",
+        "thread_min_wall_s",
+        "thread_max_wall_s",
+        "thread_mean_wall_s",
+        "bytes",
+        "flops",
+        "GB_per_s",
+        "GFLOP_per_s",
+        "percent_of_peak_bandwidth",
+        "percent_of_peak_flops",
+    };
+    return columns;
+}
+
+std::vector<double> Timer::reportValues(int node) const
+{
+    const TimerNode& timerNode = nodes[node];
+    const Chrono& timeKeeper = timerNode.timeKeeper;
+    const double wall = secondsFromWall(correctedWallTime(node));
+    const double parentWall
+        = (timerNode.parent >= 0) ? secondsFromWall(correctedWallTime(timerNode.parent)) : wall;
+    const PerfCounters::Values& counters = timerNode.counters;
+
+    return std::vector<double> {
+        static_cast<double>(timeKeeper.ticks()),
+        wall,
+        timeKeeper.cpuTime(),
+        ratio(wall, timeKeeper.ticks()),
+        100 * ratio(wall, parentWall),
+        static_cast<double>(timerNode.items),
+        ratio(timerNode.items, wall),
+        static_cast<double>(counters[PerfCounters::CYCLES]),
+        static_cast<double>(counters[PerfCounters::INSTRUCTIONS]),
+        static_cast<double>(counters[PerfCounters::LLC_MISSES]),
+        static_cast<double>(counters[PerfCounters::BRANCH_MISSES]),
+        ratio(counters[PerfCounters::INSTRUCTIONS], counters[PerfCounters::CYCLES]),
+        static_cast<double>(timerNode.allocations.allocations),
+        static_cast<double>(timerNode.allocations.bytes),
+        static_cast<double>(timerNode.peakResident),
+        static_cast<double>(timerNode.threadCount),
+        secondsFromWall(timerNode.threadMin),
+        secondsFromWall(timerNode.threadMax),
+        ratio(secondsFromWall(timerNode.threadSum), timerNode.threadCount),
+        timerNode.bytes,
+        timerNode.flops,
+        1e-9 * ratio(timerNode.bytes, wall),
+        1e-9 * ratio(timerNode.flops, wall),
+        100 * ratio(ratio(timerNode.bytes, wall), peakRates().bytesPerSecond),
+        100 * ratio(ratio(timerNode.flops, wall), peakRates().flopsPerSecond),
+    };
+}
+
+std::ostream& Timer::reportJSON(std::ostream& os) const
+{
+    const std::streamsize precision = os.precision(9);
+    reportJSON(root, os, "");
+    os << std::endl;
+    os.precision(precision);
+    return os;
+}
+
+std::ostream& Timer::reportJSON(int node, std::ostream& os, const std::string& indent) const
+{
+    const std::vector<std::string>& columns = reportColumns();
+    const std::vector<double> values = reportValues(node);
+
+    os << indent << "{\"name\": \"" << jsonEscape(name(nodes[node].id)) << "\"";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        os << ", \"" << columns[i] << "\": " << values[i];
+    }
+    os << ", \"children\": [";
+    bool first = true;
+    for (auto& child : nodes[node].childNodes) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        reportJSON(child.second, os, indent + "  ");
+    }
+    os << "]}";
+    return os;
+}
+
+std::ostream& Timer::reportCSV(std::ostream& os) const
+{
+    os << "path";
+    for (auto& column : reportColumns()) {
+        os << "," << column;
+    }
+    os << std::endl;
+    const std::streamsize precision = os.precision(9);
+    reportCSV(root, os, "");
+    os.precision(precision);
+    return os;
+}
+
+std::ostream& Timer::reportCSV(int node, std::ostream& os, const std::string& parentPath) const
+{
+    const std::string path
+        = (node == root) ? name(nodes[node].id) : parentPath + "/" + name(nodes[node].id);
+    os << csvField(path);
+    for (double value : reportValues(node)) {
+        os << "," << value;
+    }
+    os << std::endl;
+    for (auto& child : nodes[node].childNodes) {
+        reportCSV(child.second, os, path);
+    }
+    return os;
+}
+
 static std::string branch = "├";
 static std::string spc = " ";
 static std::string cont = "│";
@@ -182,17 +798,17 @@ std::string extendPrefix(const std::string& prefix)
     return std::regex_replace(newPrefix, std::regex(last), spc);
 }
 
-std::ostream& Timer::TimerNode::reportAll(std::ostream& os, const std::string& prefix) const
+std::ostream& Timer::reportAll(int node, std::ostream& os, const std::string& prefix) const
 {
-    report(os, prefix);
+    report(node, os, prefix);
     os << std::endl;
 
-    int nNodes = childNodes.size();
+    int nNodes = nodes[node].childNodes.size();
     int iNode = 0;
 
-    for (auto& child : childNodes) {
+    for (auto& child : nodes[node].childNodes) {
         std::string lastBranch = (++iNode == nNodes) ? last : branch;
-        child.second.reportAll(os, extendPrefix(prefix) + lastBranch);
+        reportAll(child.second, os, extendPrefix(prefix) + lastBranch);
     }
     return os;
 }
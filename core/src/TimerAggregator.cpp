@@ -0,0 +1,118 @@
+/*!
+ * @file TimerAggregator.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "include/TimerAggregator.hpp"
+#include "include/Timer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nextsim {
+
+// Splits a line of CSV into fields, removing any quoting
+static std::vector<std::string> splitCSV(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += c;
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back("");
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+TimerAggregator::TimerAggregator()
+    : m_reports(0)
+{
+}
+
+void TimerAggregator::addCSV(std::istream& is)
+{
+    std::string line;
+    if (!std::getline(is, line))
+        throw std::invalid_argument("TimerAggregator: empty report");
+    std::vector<std::string> header = splitCSV(line);
+    // The first column is the timer path
+    header.erase(header.begin());
+    if (m_reports == 0) {
+        m_columns = header;
+    } else if (header != m_columns) {
+        throw std::invalid_argument("TimerAggregator: report columns differ");
+    }
+
+    while (std::getline(is, line)) {
+        if (line.empty())
+            continue;
+        std::vector<std::string> fields = splitCSV(line);
+        if (fields.size() != m_columns.size() + 1)
+            throw std::invalid_argument("TimerAggregator: wrong number of values in " + line);
+
+        const std::string& path = fields[0];
+        auto found = m_statistics.find(path);
+        if (found == m_statistics.end()) {
+            m_paths.push_back(path);
+            std::vector<Statistics> empty(m_columns.size(), Statistics { 0, 0, 0, 0 });
+            found = m_statistics.insert(std::make_pair(path, empty)).first;
+        }
+        std::vector<Statistics>& stats = found->second;
+        for (size_t i = 0; i < m_columns.size(); ++i) {
+            double value = std::stod(fields[i + 1]);
+            Statistics& stat = stats[i];
+            stat.min = (stat.count > 0) ? std::min(stat.min, value) : value;
+            stat.max = (stat.count > 0) ? std::max(stat.max, value) : value;
+            stat.sum += value;
+            ++stat.count;
+        }
+    }
+    ++m_reports;
+}
+
+const TimerAggregator::Statistics& TimerAggregator::statistics(
+    const std::string& path, const std::string& column) const
+{
+    auto iColumn = std::find(m_columns.begin(), m_columns.end(), column);
+    if (iColumn == m_columns.end())
+        throw std::out_of_range("TimerAggregator: no column " + column);
+    return m_statistics.at(path).at(iColumn - m_columns.begin());
+}
+
+std::ostream& TimerAggregator::writeCSV(std::ostream& os) const
+{
+    os << "path,reports";
+    for (auto& column : m_columns) {
+        os << "," << column << "_min," << column << "_max," << column << "_mean";
+    }
+    os << std::endl;
+
+    const std::streamsize precision = os.precision(9);
+    for (auto& path : m_paths) {
+        const std::vector<Statistics>& stats = m_statistics.at(path);
+        os << Timer::csvField(path) << "," << stats.front().count;
+        for (auto& stat : stats) {
+            os << "," << stat.min << "," << stat.max << "," << stat.mean();
+        }
+        os << std::endl;
+    }
+    os.precision(precision);
+    return os;
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,42 @@
+/*!
+ * @file aggregate_timers.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Combines CSV timer reports, such as those of the ranks of a parallel run,
+ * into the minimum, maximum and mean of each value. The combined statistics
+ * are written to standard output as CSV.
+ *
+ * Usage: aggregate_timers report1.csv [report2.csv ...]
+ */
+
+#include "include/TimerAggregator.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " report1.csv [report2.csv ...]" << std::endl;
+        return 1;
+    }
+
+    Nextsim::TimerAggregator aggregator;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream report(argv[i]);
+            if (!report) {
+                std::cerr << "Could not open " << argv[i] << std::endl;
+                return 1;
+            }
+            aggregator.addCSV(report);
+        }
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    aggregator.writeCSV(std::cout);
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*!
+ * @file AllocationCounter.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_ALLOCATIONCOUNTER_HPP
+#define CORE_SRC_INCLUDE_ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class providing per-thread counts of heap allocations.
+ *
+ * @details The counts are only incremented when AllocationCounter.cpp is
+ * linked into the executable, as it replaces the global operator new. Without
+ * it, the counts remain zero and installed() returns false.
+ */
+class AllocationCounter {
+public:
+    //! Counts of heap allocations.
+    struct Counts {
+        //! Number of calls to operator new.
+        uint64_t allocations;
+        //! Number of bytes requested from operator new.
+        uint64_t bytes;
+    };
+
+    //! Returns the allocation counts of the calling thread.
+    static Counts& threadCounts()
+    {
+        // Zero initialized without a guard, so safe to use within operator new
+        thread_local Counts counts;
+        return counts;
+    }
+
+    //! Returns whether the allocation counting operator new is linked.
+    static bool installed() { return installedFlag(); }
+
+    //! Records that the allocation counting operator new is linked.
+    static bool install() { return installedFlag() = true; }
+
+private:
+    static bool& installedFlag()
+    {
+        static bool flag = false;
+        return flag;
+    }
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_ALLOCATIONCOUNTER_HPP */
@@ -0,0 +1,144 @@
+/*!
+ * @file CapacityPlan.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_CAPACITYPLAN_HPP
+#define CORE_SRC_INCLUDE_CAPACITYPLAN_HPP
+
+#include "include/Configured.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class projecting the resources that a run of the model will need.
+ *
+ * @details The plan is built from the configuration and the metadata of the
+ * restart file, without reading any data, and reports the memory per process,
+ * the volume of I/O per simulated day and an estimate of the run time.
+ *
+ * The run time is estimated from calibrated costs: the cost of stepping one
+ * column, from the CSV output of nextsim_column_proxy, and the rates of
+ * writing and reading restart files, from the CSV output of nextsim_io_bench.
+ * These are measured on the machine of the planned run and given with the
+ * capacity.column_costs and capacity.io_rates options. Without them, only the
+ * memory and I/O volume are projected.
+ *
+ * The capacity.output_interval and capacity.checkpoint_interval options give
+ * the number of time steps between the outputs and the restart checkpoints of
+ * the planned run, each the size of a restart file. Zero means none.
+ */
+class CapacityPlan : public Configured<CapacityPlan> {
+public:
+    CapacityPlan();
+
+    enum {
+        PROCESSES_KEY,
+        THREADS_KEY,
+        OUTPUTINTERVAL_KEY,
+        CHECKPOINTINTERVAL_KEY,
+        COLUMNCOSTS_KEY,
+        IORATES_KEY,
+    };
+
+    void configure() override;
+
+    /*!
+     * @brief Sets the grid of the run.
+     *
+     * @param structureName The name of the structure of the restart file.
+     * @param nx The number of elements in the x direction.
+     * @param ny The number of elements in the y direction.
+     * @param nLayers The number of ice layers.
+     */
+    void setGrid(const std::string& structureName, int nx, int ny, int nLayers);
+    /*!
+     * @brief Sets the time steps of the run.
+     *
+     * @param nSteps The number of time steps.
+     * @param timestep The length of each time step [s].
+     */
+    void setRun(int nSteps, int timestep);
+    //! Sets the implementation of each module, to be reported.
+    void setModules(const std::map<std::string, std::string>& implementations);
+
+    /*!
+     * @brief Reads the cost of stepping a column from the CSV output of
+     * nextsim_column_proxy.
+     *
+     * @details The cost is the ns per column step of the total of all
+     * passes, which is per thread. Throws std::invalid_argument if the stream
+     * does not hold that output.
+     */
+    void readColumnCosts(std::istream& is);
+    /*!
+     * @brief Reads the rates of writing and reading restart files from the
+     * CSV output of nextsim_io_bench.
+     *
+     * @details The rates of the total dump and init operations of the largest
+     * file measured are used. Throws std::invalid_argument if the stream does
+     * not hold that output.
+     */
+    void readIORates(std::istream& is);
+
+    //! Returns the number of columns held by each process.
+    size_t columnsPerProcess() const;
+    /*!
+     * @brief Returns the projected peak memory of the model data of each
+     * process [bytes].
+     *
+     * @details The size of the column physics is that of the implementation
+     * of IPhysics1d set in the ModuleLoader. Throws std::logic_error if none
+     * has been set.
+     */
+    double memoryPerProcess() const;
+    //! Returns the size of the data of one restart file [bytes].
+    double restartBytes() const;
+    //! Returns the volume of output and checkpoints per simulated day [bytes].
+    double ioBytesPerDay() const;
+    //! Returns the volume read during the run [bytes].
+    double bytesRead() const;
+    //! Returns the volume written during the run [bytes].
+    double bytesWritten() const;
+    //! Returns the estimated time of the column physics [s], or zero if uncalibrated.
+    double computeSeconds() const;
+    //! Returns the estimated time of the I/O [s], or zero if uncalibrated.
+    double ioSeconds() const;
+
+    //! Writes the plan as text.
+    void report(std::ostream& os) const;
+
+private:
+    // Returns the number of times a file is written in the run at the given
+    // interval of time steps
+    int writesPerRun(int interval) const;
+
+    int m_processes;
+    int m_threads;
+    int m_outputInterval;
+    int m_checkpointInterval;
+
+    std::string m_structureName;
+    int m_nx;
+    int m_ny;
+    int m_nLayers;
+    int m_nSteps;
+    int m_timestep;
+    std::map<std::string, std::string> m_implementations;
+
+    // Calibrated costs, zero until read
+    double m_nsPerColumn;
+    double m_writeBytesPerSecond;
+    double m_readBytesPerSecond;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_CAPACITYPLAN_HPP */
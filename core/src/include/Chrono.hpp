@@ -16,14 +16,16 @@ namespace Nextsim {
  * @brief A class providing a timer.
  *
  * @details This class records execution wall and CPU time as well as a record
- * of the number of times that the chronometer has been started.
+ * of the number of times that the chronometer has been started. The wall time
+ * is taken from the monotonic steady clock. Sampling the CPU clock is much
+ * more expensive, so it is only done when enabled by sampleCpuTime().
  */
 class Chrono {
 public:
     //! Type of a point in time for the wall clock.
-    typedef std::chrono::high_resolution_clock::time_point WallTimePoint;
+    typedef std::chrono::steady_clock::time_point WallTimePoint;
     //! Type of a time duration on the wall clock.
-    typedef std::chrono::high_resolution_clock::duration WallTimeDuration;
+    typedef std::chrono::steady_clock::duration WallTimeDuration;
 
     //! Type of a point in time for the CPU clock.
     typedef std::clock_t CpuTimePoint;
@@ -35,7 +37,8 @@ public:
         : m_wallTime(WallTimeDuration::zero())
         , m_cpuTime(0)
         , m_ticks(0)
-        , m_running(false) {};
+        , m_running(false)
+        , m_cpuRunning(false) {};
     ~Chrono() = default;
 
     //! Returns the current time on the wall clock.
@@ -53,6 +56,7 @@ public:
         m_cpuTime = 0;
         m_ticks = 0;
         m_running = false;
+        m_cpuRunning = false;
     }
 
     //! Returns the current time on the CPU clock.
@@ -60,7 +64,7 @@ public:
     //! Returns the current cumulative CPU clock timer.
     inline CpuTimeDuration cpuTime() const
     {
-        return m_cpuTime + (m_running ? cpuTimeSinceHack() : 0);
+        return m_cpuTime + (m_cpuRunning ? cpuTimeSinceHack() : 0);
     };
 
     //! Returns the current number of activation ticks.
@@ -68,31 +72,45 @@ public:
     //! Returns whether this chronometer is running.
     inline bool running() const { return m_running; };
 
+    /*!
+     * @brief Sets whether chronometers started from now on sample the CPU clock.
+     *
+     * @param sample true to sample the CPU clock, false to only use the wall clock.
+     */
+    static void sampleCpuTime(bool sample) { cpuSampling() = sample; }
+    //! Returns whether chronometers sample the CPU clock.
+    static bool isSamplingCpuTime() { return cpuSampling(); }
+
     /*!
      * @brief Starts the timer.
      *
-     * @details Starts the clock on both the wall and CPU clocks, increments
-     * the number of activation ticks and sets the running flag.
+     * @details Starts the clock on the wall clock, and the CPU clock if it is
+     * being sampled, increments the number of activation ticks and sets the
+     * running flag.
      */
     inline void start()
     {
-        m_wallHack = std::chrono::high_resolution_clock::now();
-        m_cpuHack = std::clock();
+        m_cpuRunning = cpuSampling();
+        if (m_cpuRunning)
+            m_cpuHack = std::clock();
         ++m_ticks;
         m_running = true;
+        m_wallHack = std::chrono::steady_clock::now();
     };
 
     /*!
      * @brief Stops the timer.
      *
-     * @details Stops both the wall and CPU clocks, updates the cumulative
-     * time for both clocks and unsets the running flag.
+     * @details Stops the wall clock and any running CPU clock, updates the
+     * cumulative time for the clocks and unsets the running flag.
      */
     void stop()
     {
         m_wallTime += wallTimeSinceHack();
-        m_cpuTime += cpuTimeSinceHack();
+        if (m_cpuRunning)
+            m_cpuTime += cpuTimeSinceHack();
         m_running = false;
+        m_cpuRunning = false;
     };
 
     /*!
@@ -125,6 +143,13 @@ private:
     int m_ticks;
 
     bool m_running;
+    bool m_cpuRunning;
+
+    static bool& cpuSampling()
+    {
+        static bool sampling = false;
+        return sampling;
+    }
 
     CpuTimeDuration cpuTimeSinceHack() const
     {
@@ -133,8 +158,7 @@ private:
 
     WallTimeDuration wallTimeSinceHack() const
     {
-        return std::chrono::duration_cast<WallTimeDuration>(
-            std::chrono::high_resolution_clock::now() - m_wallHack);
+        return std::chrono::steady_clock::now() - m_wallHack;
     }
 };
 
@@ -34,6 +34,12 @@ public:
      */
     std::vector<std::string> getConfigFileNames();
 
+    /*!
+     * Returns whether the run should only be planned, reporting the resources
+     * it would need, rather than performed.
+     */
+    bool isDryRun() const;
+
 private:
     CommandLineParser() = default;
 
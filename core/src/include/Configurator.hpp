@@ -8,11 +8,16 @@
 #ifndef SRC_INCLUDE_CONFIGURATOR_HPP
 #define SRC_INCLUDE_CONFIGURATOR_HPP
 
+#include <boost/any.hpp>
 #include <boost/program_options.hpp>
 #include <fstream>
+#include <iostream>
 #include <istream>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace Nextsim {
@@ -24,6 +29,11 @@ namespace Nextsim {
  * be updated. Whatever is parsed first sets the value of that option. This
  * allows the command line to override values in config files, as it is always
  * parsed first
+ *
+ * Each source is parsed once, when it is added, into a store of the values of
+ * every option it contains, indexed by the option name. Retrieving options
+ * then only looks them up in the store, so the cost of configuring a class
+ * does not depend on the length of the config files.
  */
 class Configurator {
 public:
@@ -58,12 +68,12 @@ public:
     /*!
      * @brief Adds a istream source of configuration data.
      *
+     * @details The stream is parsed immediately and is not kept. Options it
+     * shares with earlier sources keep their earlier values.
+     *
      * @param pis a std::unique_ptr to a std::istream containing the config data.
      */
-    inline static void addStream(std::unique_ptr<std::istream> pis)
-    {
-        sources.push_back(std::move(pis));
-    }
+    static void addStream(std::unique_ptr<std::istream> pis);
     /*!
      * @brief Adds several istream sources of configuration data.
      *
@@ -83,7 +93,7 @@ public:
     /*!
      * Removes previously assigned stream data sources, both files and istreams.
      */
-    inline static void clearStreams() { sources.clear(); }
+    static void clearStreams();
 
     /*!
      * Removes all data sources, both streams and command line.
@@ -98,23 +108,28 @@ public:
      *
      * @details The data is formatted as the C standard argc and argv values.
      * Any values defined here will override the corresponding values that
-     * might be found in the config files.
+     * might be found in the config files. Options are given as --name=value
+     * or --name value, or as --name alone for a switch. The argument after
+     * --name is its value unless it starts with '-', apart from negative
+     * numbers such as "--name -5". A switch only takes the argument after it
+     * if that is a boolean value, so that in "--verbose input.nc" input.nc
+     * is a positional argument and the switch is set. The switches are the
+     * bool options of get() and the options of parse() that take no value.
+     * The values of an option given more than once are collected in order,
+     * so that a repeated option fills a vector option, while converting it
+     * to a single value throws, as boost::program_options does.
      *
      * @param argc the number of arguments to be parsed
      * @param argv an array of zero terminated character arrays making up the
      * command line arguments, with an addition null at argv[argc].
      */
-    inline static void setCommandLine(int argc, char* argv[])
-    {
-        m_argc = argc;
-        m_argv = argv;
-    }
+    static void setCommandLine(int argc, char* argv[]);
 
     /*!
-     * @brief Parses all configuration sources.
+     * @brief Retrieves options from all configuration sources.
      *
-     * @details Parses all the the stored configuration sources for the
-     * configuration options specified in the options description. The command
+     * @details Looks up the configuration options specified in the options
+     * description in the values parsed from all the sources. The command
      * line options are parsed first. Subsequent matching options will not
      * update the value of the option, so whatever is parsed first sets the
      * value of that option. This allows the command line to override values in
@@ -126,11 +141,65 @@ public:
     static boost::program_options::variables_map parse(
         const boost::program_options::options_description& opt);
 
+    /*!
+     * @brief Gets the value of a single option.
+     *
+     * @details The value is converted to the type of the default value as
+     * boost::program_options would convert it, and the converted value is
+     * cached for later calls. As in parse(), a value from a config stream
+     * that cannot be converted is echoed and the default value returned,
+     * while a command line value that cannot be converted throws.
+     *
+     * @param name The name of the option, including any section prefix.
+     * @param defaultValue The value to return if no source sets the option.
+     */
+    template <typename T> static T get(const std::string& name, const T& defaultValue)
+    {
+        const std::vector<std::string>* tokens = find(name);
+        if (!tokens)
+            return defaultValue;
+        boost::any& cached = typedValues[name];
+        if (const T* value = boost::any_cast<T>(&cached))
+            return *value;
+        std::unique_ptr<boost::program_options::typed_value<T>> semantic(
+            boost::program_options::value<T>());
+        cached = boost::any();
+        try {
+            semantic->xparse(cached, *tokens);
+        } catch (std::exception& e) {
+            if (std::is_same<T, bool>::value && separateValues.count(name)) {
+                // A switch followed by a positional argument
+                cached = boost::any();
+                semantic->xparse(cached, std::vector<std::string>());
+                return boost::any_cast<T>(cached);
+            }
+            typedValues.erase(name);
+            if (commandLineValues.count(name))
+                throw;
+            // Echo the exception, but carry on
+            std::cerr << e.what() << std::endl;
+            return defaultValue;
+        }
+        return boost::any_cast<T>(cached);
+    }
+
+    //! Returns the number of times a configuration source has been parsed.
+    static int parseCount() { return m_parseCount; }
+
 private:
-    static std::vector<std::unique_ptr<std::istream>> sources;
+    // The values of an option from the command line, or else from the first
+    // stream that sets it, or null if it is not set.
+    static const std::vector<std::string>* find(const std::string& name);
 
-    static int m_argc;
-    static char** m_argv;
+    typedef std::map<std::string, std::vector<std::string>> Store;
+    static Store commandLineValues;
+    static Store streamValues;
+    // The options given a value by the argument after them on the command
+    // line, which a switch does not take
+    static std::set<std::string> separateValues;
+    // Values already converted by get(), by option name
+    static std::map<std::string, boost::any> typedValues;
+    static int m_parseCount;
 };
 
 } /* namespace Nextsim */
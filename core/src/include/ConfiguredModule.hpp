@@ -21,7 +21,13 @@ public:
     ConfiguredModule() = default;
     virtual ~ConfiguredModule() = default;
 
-    //! Parse the configuration for all of the modules defined in ModuleLoader.
+    /*!
+     * @brief Parse the configuration for all of the modules defined in
+     * ModuleLoader.
+     *
+     * @details Also sets the interval of the sampled timing of the modules
+     * from the option named by TIMING_KEY.
+     */
     static void parseConfigurator();
 
     /*!
@@ -33,6 +39,8 @@ public:
 
     //! The configuration options section name for modules.
     static const std::string MODULE_PREFIX;
+    //! The option name, within the modules section, of the module timing interval.
+    static const std::string TIMING_KEY;
 };
 
 } /* namespace Nextsim */
@@ -17,19 +17,57 @@ namespace Nextsim {
 
 class DevGrid;
 
+/*!
+ * @brief The netCDF reading and writing of DevGrid.
+ *
+ * @details The reading and writing are timed, with a child timer for the
+ * metadata and for each variable, so that the timer reports hold the rate at
+ * which each variable is read or written. The variables of the files written
+ * can be chunked and compressed.
+ */
 class DevGridIO : public IDevGridIO {
 public:
     DevGridIO(DevGrid& grid)
         : IDevGridIO(grid)
+        , m_deflateLevel(0)
+        , m_shuffle(false)
+        , m_chunkX(0)
+        , m_chunkY(0)
     {
     }
     virtual ~DevGridIO() = default;
 
     void init(std::vector<ElementData>& data, const std::string& filePath) const override;
+    int initSize(const std::string& filePath) const override;
     void dump(const std::vector<ElementData>& data, const std::string& filePath) const override;
 
+    /*!
+     * @brief Sets the compression of the variables of the files written.
+     *
+     * @param deflateLevel The zlib compression level, from 0 for no
+     * compression to 9.
+     * @param shuffle Whether the bytes of the values are shuffled before
+     * compression.
+     */
+    void setCompression(int deflateLevel, bool shuffle = true);
+    /*!
+     * @brief Sets the size of the chunks of the variables of the files written.
+     *
+     * @details Chunks are clipped to the size of the grid, and hold all the
+     * ice layers of their elements. With zero sizes the variables are stored
+     * contiguously if uncompressed, and in chunks chosen by the netCDF library
+     * if compressed.
+     *
+     * @param chunkX The number of elements of a chunk in the x direction.
+     * @param chunkY The number of elements of a chunk in the y direction.
+     */
+    void setChunking(int chunkX, int chunkY);
+
 private:
-    DevGrid* grid;
+    int m_deflateLevel;
+    bool m_shuffle;
+    int m_chunkX;
+    int m_chunkY;
 };
 
 } /* namespace Nextsim */
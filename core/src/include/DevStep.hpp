@@ -8,6 +8,7 @@
 #ifndef CORE_SRC_INCLUDE_DEVSTEP_HPP
 #define CORE_SRC_INCLUDE_DEVSTEP_HPP
 
+#include "include/HealthCheck.hpp"
 #include "include/IModelStep.hpp"
 #include "include/IStructure.hpp"
 
@@ -17,7 +18,10 @@ namespace Nextsim {
 
 class DevStep : public IModelStep {
 public:
-    DevStep() = default;
+    DevStep()
+        : pStructure(nullptr)
+        , checkHealth(false)
+        , nSteps(0) {};
     virtual ~DevStep() = default;
 
     // Member functions inherited from IModelStep
@@ -31,8 +35,125 @@ public:
     void iterate(const Iterator::Duration& dt) override;
     void stop(const Iterator::TimePoint& stopTime) override {};
 
+    /*!
+     * @brief Enables the health check of the prognostic fields of every
+     * column at the end of each time step.
+     *
+     * @details A step that leaves any column unhealthy throws
+     * std::runtime_error, reporting the state of up to maxColumns of the
+     * failing columns. Zero disables the check.
+     */
+    void setHealthCheck(int maxColumns);
+    //! Returns the health check, holding the failing columns of the last step.
+    const HealthCheck& getHealthCheck() const { return healthCheck; }
+
+    //! The stages of the column physics, in the order that stepColumn() runs them.
+    enum Stage {
+        DERIVED_DATA,
+        FLUXES,
+        THERMODYNAMICS,
+        INTEGRATION,
+        N_STAGES,
+    };
+    //! The name of a stage, which is also the name of its timer.
+    static const char* stageName(Stage stage);
+
+    /*!
+     * @brief Steps the column physics of one column.
+     *
+     * @details The derived quantities, the derived data, the fluxes and
+     * thermodynamics and the integration of the column follow each other
+     * while its data is in cache, so that each step reads the data of a
+     * column from memory only once. The time step is that set in
+     * PrognosticData::setTimestep().
+     *
+     * @param data The data of the column.
+     */
+    static void stepColumn(ElementData& data)
+    {
+        data.cacheDerivedQuantities();
+        data.updateDerivedData(data, data, data);
+        data.calculate(data, data, data);
+        data.updateAndIntegrate(data);
+    }
+    /*!
+     * @brief Steps the column physics of one column, timing each stage.
+     *
+     * @details Runs the stages of stepColumn(), each within the timer named
+     * by stageName(), started as a child of the running timer of the calling
+     * thread. The work of the stage in this column is added to its timer.
+     *
+     * @param data The data of the column.
+     */
+    static void stepColumnStages(ElementData& data);
+
+    /*!
+     * @brief Steps the column physics of a contiguous range of columns.
+     *
+     * @details The column loop of iterate(), also used by the drivers which
+     * hold the columns themselves, such as those dividing the columns between
+     * threads, so that every path steps the columns with the same code. One
+     * in every stageSampling() columns is stepped by stepColumnStages(), so
+     * that the stage timers hold the time and work of the sampled columns
+     * only.
+     *
+     * @param first The first column.
+     * @param last One past the last column.
+     * @param check The health check recording the failing columns, or null
+     * for no check.
+     * @param firstIndex The index of the first column in the reports of the
+     * health check.
+     * @return The total number of ice layers of the columns.
+     */
+    static long stepColumns(
+        ElementData* first, ElementData* last, HealthCheck* check = nullptr, long firstIndex = 0);
+
+    //! Returns the number of columns stepped per column whose stages are timed.
+    static int stageSampling() { return s_stageSampling; }
+    /*!
+     * @brief Sets the number of columns stepped per column whose stages are
+     * timed.
+     *
+     * @param interval The sampling interval, or zero to time no stages.
+     */
+    static void setStageSampling(int interval) { s_stageSampling = interval; }
+
+    /*!
+     * @brief Returns the floating point operations of one stage of stepping
+     * the columns counted by a derived data report.
+     *
+     * @details The operations are counted on the ice covered path of the
+     * default implementations of the physics modules, with each call to
+     * exp(), pow(), fmin() or fmax() as a single operation.
+     *
+     * @param stage The stage.
+     * @param report The derived data report of the stepped columns.
+     */
+    static double stageFlops(Stage stage, const IPhysics1d::DerivedDataReport& report);
+    /*!
+     * @brief Returns the bytes of the fields read and written by one stage
+     * of stepping the columns counted by a derived data report.
+     *
+     * @param stage The stage.
+     * @param report The derived data report of the stepped columns.
+     * @param nLayers The total number of ice layers of the columns.
+     */
+    static double stageBytes(
+        Stage stage, const IPhysics1d::DerivedDataReport& report, long nLayers);
+    //! Returns the floating point operations of all the stages.
+    static double columnFlops(const IPhysics1d::DerivedDataReport& report);
+    //! Returns the bytes read and written by all the stages.
+    static double columnBytes(const IPhysics1d::DerivedDataReport& report, long nLayers);
+
 private:
     IStructure* pStructure;
+
+    bool checkHealth;
+    HealthCheck healthCheck;
+    // The number of steps taken, for the report of the health check
+    long nSteps;
+
+    static int s_stageSampling;
 };
 
 } /* namespace Nextsim */
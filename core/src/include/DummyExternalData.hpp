@@ -22,14 +22,14 @@ public:
     static void setAll(IStructure& is)
     {
         for (is.cursor = 0; is.cursor; ++is.cursor) {
-            is.cursor->airTemperature() = -1;
-            is.cursor->dewPoint2m() = -4;
-            is.cursor->airPressure() = 1e5;
-            is.cursor->ExternalData::mixingRatio() = -1.;
-            is.cursor->incomingShortwave() = 0; // night
-            is.cursor->incomingLongwave() = 311;
-            is.cursor->mixedLayerDepth() = 10;
-            is.cursor->snowfall() = 0;
+            is.cursor->setAirTemperature(-1)
+                .setDewPoint2m(-4)
+                .setAirPressure(1e5)
+                .setMixingRatio(-1.)
+                .setIncomingShortwave(0) // night
+                .setIncomingLongwave(311)
+                .setMixedLayerDepth(10)
+                .setSnowfall(0);
         }
     }
 
@@ -63,6 +63,11 @@ public:
 
     void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
 
+    void calculateFluxes(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+
+    void calculateThermodynamics(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+
 private:
     std::unique_ptr<IPhysics1d> m_physicsImplData;
 };
@@ -8,72 +8,110 @@
 #define SRC_INCLUDE_EXTERNALDATA_HPP
 
 #include "BaseElementData.hpp"
+#include "Precision.hpp"
 #include "constants.hpp"
 
 namespace Nextsim {
 
-//! A class holding all of the data for an element that is imported from
-//! external sources (coupled models, climatologies).
+/*!
+ * @brief A class holding all of the data for an element that is imported from
+ * external sources (coupled models, climatologies).
+ *
+ * @details The values are stored with the Forcing type of the build's
+ * Precision policy. They are read through the const accessors and written
+ * through the set functions.
+ */
 class ExternalData : public BaseElementData {
 public:
-    ExternalData() = default;
+    ExternalData();
     ~ExternalData() = default;
 
-    //! Reference to the air temperature at 2 m [˚C]
-    inline double& airTemperature() { return m_tair; };
     //! Air temperature at 2 m [˚C]
     inline double airTemperature() const { return m_tair; }
+    //! Sets the air temperature at 2 m [˚C]
+    inline ExternalData& setAirTemperature(double value)
+    {
+        m_tair = value;
+        return *this;
+    }
 
-    //! Reference to the dew point temperature at 2 m [˚C]
-    inline double& dewPoint2m() { return m_dair; };
     //! Dew point temperature at 2 m [˚C]
-    inline double dewPoint2m() const { return m_dair; };
+    inline double dewPoint2m() const { return m_dair; }
+    //! Sets the dew point temperature at 2 m [˚C]
+    inline ExternalData& setDewPoint2m(double value)
+    {
+        m_dair = value;
+        return *this;
+    }
 
-    //! Reference to the sea level atmospheric pressure [Pa]
-    inline double& airPressure() { return m_slp; };
     //! Sea level atmospheric pressure [Pa]
     inline double airPressure() const { return m_slp; }
+    //! Sets the sea level atmospheric pressure [Pa]
+    inline ExternalData& setAirPressure(double value)
+    {
+        m_slp = value;
+        return *this;
+    }
 
-    //! Reference to the water vapour mixing ratio [kg kg⁻¹]
-    inline double& mixingRatio() { return m_mixrat; };
     //! Water vapour mixing ratio [kg kg⁻¹]
     inline double mixingRatio() const { return m_mixrat; }
-
+    //! Sets the water vapour mixing ratio [kg kg⁻¹]
+    inline ExternalData& setMixingRatio(double value)
+    {
+        m_mixrat = value;
+        return *this;
+    }
     //! Does the element have a valid value of water vapour mixing ratio?
     inline bool hasMixingRatio() const { return (m_mixrat >= 0) && (m_mixrat <= 1); };
 
-    //! Reference to the incoming short wave radiation flux [W m⁻²]
-    inline double& incomingShortwave() { return m_Qsw_in; }
     //! Incoming short wave radiation flux [W m⁻²]
     inline double incomingShortwave() const { return m_Qsw_in; }
+    //! Sets the incoming short wave radiation flux [W m⁻²]
+    inline ExternalData& setIncomingShortwave(double value)
+    {
+        m_Qsw_in = value;
+        return *this;
+    }
 
-    //! Reference to the incoming long wave radiation flux [W m⁻²]
-    inline double& incomingLongwave() { return m_Qlw_in; }
     //! Incoming long wave radiation flux [W m⁻²]
     inline double incomingLongwave() const { return m_Qlw_in; }
+    //! Sets the incoming long wave radiation flux [W m⁻²]
+    inline ExternalData& setIncomingLongwave(double value)
+    {
+        m_Qlw_in = value;
+        return *this;
+    }
 
-    //! Reference to the depth of the ocean mixed layer [m]
-    inline double& mixedLayerDepth() { return m_mld; };
     //! Depth of the ocean mixed layer [m]
     inline double mixedLayerDepth() const { return m_mld; }
+    //! Sets the depth of the ocean mixed layer [m]
+    inline ExternalData& setMixedLayerDepth(double value)
+    {
+        m_mld = value;
+        return *this;
+    }
     //! The areal mixed layer heat capacity [J K⁻¹ m⁻²]
     inline double mixedLayerBulkHeatCapacity() const { return m_mld * Water::rhoOcean * Water::cp; }
 
-    //! Reference to the snowfall rate [kg m⁻² s⁻¹]
-    inline double& snowfall() { return m_snowfall; }
     //! Snowfall rate [kg m⁻² s⁻¹]
     inline double snowfall() const { return m_snowfall; }
+    //! Sets the snowfall rate [kg m⁻² s⁻¹]
+    inline ExternalData& setSnowfall(double value)
+    {
+        m_snowfall = value;
+        return *this;
+    }
 
 private:
-    double m_tair;
-    double m_dair;
-    double m_slp;
-    double m_mixrat;
-    double m_Qsw_in;
-    double m_Qlw_in;
-    double m_mld;
-
-    double m_snowfall;
+    Precision::Forcing m_tair;
+    Precision::Forcing m_dair;
+    Precision::Forcing m_slp;
+    Precision::Forcing m_mixrat;
+    Precision::Forcing m_Qsw_in;
+    Precision::Forcing m_Qlw_in;
+    Precision::Forcing m_mld;
+
+    Precision::Forcing m_snowfall;
 };
 
 } /* namespace Nextsim */
@@ -0,0 +1,136 @@
+/*!
+ * @file FieldComparison.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_FIELDCOMPARISON_HPP
+#define CORE_SRC_INCLUDE_FIELDCOMPARISON_HPP
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class comparing fields against those of a reference run.
+ *
+ * @details A value passes if it differs from the reference value by no more
+ * than the absolute tolerance plus the relative tolerance times the magnitude
+ * of the reference value. NaN values pass only where the reference is also
+ * NaN. Each field has its own tolerances, or the default ones. The distances
+ * in units in the last place (ULPs) between the values are collected in a
+ * histogram with power of two bins, so that small rounding differences can
+ * be told apart from real errors. Large fields are compared on several
+ * threads.
+ */
+class FieldComparison {
+public:
+    //! The tolerances of the values of a field.
+    struct Tolerance {
+        double absolute;
+        double relative;
+    };
+
+    //! The result of comparing one field.
+    struct Result {
+        std::string name;
+        size_t size;
+        //! The number of values outside the tolerances.
+        size_t failures;
+        //! The index of the first value outside the tolerances, or size if none are.
+        size_t firstFailure;
+        double maxAbsolute;
+        double maxRelative;
+        /*!
+         * The number of values in each ULP bin. Bin 0 holds the identical
+         * values, bin k > 0 those between 2^(k-1) and 2^k - 1 ULPs apart, and
+         * the last bin the values where only one of the pair is NaN.
+         */
+        std::vector<size_t> ulpHistogram;
+
+        bool passed() const { return failures == 0; }
+    };
+
+    //! The number of bins of the ULP histograms.
+    static const int ulpBins;
+
+    /*!
+     * @brief Creates a comparison with zero default tolerances.
+     *
+     * @param nThreads The largest number of threads comparing each field, or
+     * zero for the number of hardware threads.
+     */
+    FieldComparison(int nThreads = 0);
+
+    //! Sets the tolerances of the fields without their own.
+    void setDefaultTolerance(const Tolerance& tolerance) { m_default = tolerance; }
+    //! Sets the tolerances of one field.
+    void setTolerance(const std::string& field, const Tolerance& tolerance)
+    {
+        m_tolerances[field] = tolerance;
+    }
+    //! Returns the tolerances of a field.
+    const Tolerance& tolerance(const std::string& field) const;
+
+    /*!
+     * @brief Reads the tolerances of fields.
+     *
+     * @details Each line holds the name of a field, its absolute tolerance and
+     * its relative tolerance, separated by white space. The field name "*"
+     * sets the default tolerances. Empty lines and lines starting with '#' are
+     * ignored. Throws std::invalid_argument on any other line.
+     *
+     * @param is The istream to read the tolerances from.
+     */
+    void readTolerances(std::istream& is);
+
+    /*!
+     * @brief Compares a field with its reference.
+     *
+     * @details Throws std::invalid_argument if the fields differ in size.
+     *
+     * @param name The name of the field, which selects its tolerances.
+     * @param reference The values of the reference run.
+     * @param test The values to be compared.
+     */
+    Result compare(const std::string& name, const std::vector<double>& reference,
+        const std::vector<double>& test) const;
+
+    /*!
+     * @brief Returns the distance between two doubles in units in the last place.
+     *
+     * @details The distance is the number of representable doubles between
+     * the two values, with zero and negative zero counted as equal.
+     */
+    static unsigned long long ulpDistance(double a, double b);
+    //! Returns the bin of the ULP histogram of a ULP distance.
+    static int ulpBin(unsigned long long distance);
+    //! Returns the range of ULP distances of a bin of the histogram as text.
+    static std::string ulpBinLabel(int bin);
+
+    /*!
+     * @brief Writes the results of comparing fields.
+     *
+     * @details Each field has a line of its size, number of failures,
+     * largest errors and tolerances, followed by the non-empty bins of its
+     * ULP histogram.
+     *
+     * @param results The results to write.
+     * @param os The ostream to write to.
+     */
+    std::ostream& writeReport(const std::vector<Result>& results, std::ostream& os) const;
+
+private:
+    int m_nThreads;
+    Tolerance m_default;
+    std::map<std::string, Tolerance> m_tolerances;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_FIELDCOMPARISON_HPP */
@@ -0,0 +1,103 @@
+/*!
+ * @file HealthCheck.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_HEALTHCHECK_HPP
+#define CORE_SRC_INCLUDE_HEALTHCHECK_HPP
+
+#include "include/PrognosticData.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class checking the numerical health of the prognostic fields of
+ * each column.
+ *
+ * @details check() classifies the state of one column with a fixed number of
+ * comparisons and no branches, so that it can be fused into a sweep over the
+ * columns at little cost. The failing columns are then passed to record(),
+ * which keeps the state of the first of them for the report.
+ */
+class HealthCheck {
+public:
+    //! The ways a column can fail, combined as bits.
+    enum Failure {
+        NOT_FINITE = 1,
+        CONCENTRATION = 2,
+        NEGATIVE_THICKNESS = 4,
+        TOO_WARM = 8,
+    };
+
+    //! The state of a failing column.
+    struct Column {
+        long index;
+        unsigned failures;
+        PrognosticData state;
+    };
+
+    static const int defaultMaxColumns = 10;
+
+    /*!
+     * @brief Constructs a check that records the state of up to maxColumns
+     * failing columns.
+     */
+    HealthCheck(int maxColumns = defaultMaxColumns);
+
+    /*!
+     * @brief Returns the failures of the prognostic state of a column, or zero
+     * if it is healthy.
+     *
+     * @details A NaN or infinity in any field makes the sum of the fields non
+     * finite, so a single comparison checks all of them. The concentration
+     * must lie in [0, 1], the ice and snow thicknesses must not be negative
+     * and the ice temperatures must not exceed the melting point of fresh ice.
+     */
+    static unsigned check(const PrognosticData& data)
+    {
+        const double conc = data.iceConcentration();
+        const double thick = data.iceThickness();
+        const double snow = data.snowThickness();
+        double sum = conc + thick + snow + data.seaSurfaceTemperature()
+            + data.seaSurfaceSalinity();
+        double warmest = -1;
+        for (double tice : data.iceTemperatures()) {
+            sum += tice;
+            warmest = (tice > warmest) ? tice : warmest;
+        }
+        return NOT_FINITE * !(sum - sum == 0) | CONCENTRATION * ((conc < 0) | (conc > 1))
+            | NEGATIVE_THICKNESS * ((thick < 0) | (snow < 0)) | TOO_WARM * (warmest > 0);
+    }
+
+    //! Records a failing column, keeping its state if it is one of the first.
+    void record(long index, const PrognosticData& data, unsigned failures);
+
+    //! Returns whether any column has failed since the last reset.
+    bool failed() const { return m_nFailed > 0; }
+    //! Returns the number of columns that have failed since the last reset.
+    long nFailed() const { return m_nFailed; }
+    //! Returns the recorded failing columns, in the order they were recorded.
+    const std::vector<Column>& columns() const { return m_columns; }
+    //! Forgets all of the failing columns.
+    void reset();
+
+    //! Writes the failures and state of the recorded columns as text.
+    void report(std::ostream& os) const;
+
+    //! Returns the names of the failures as a comma separated list.
+    static std::string failureNames(unsigned failures);
+
+private:
+    int m_maxColumns;
+    long m_nFailed;
+    std::vector<Column> m_columns;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_HEALTHCHECK_HPP */
@@ -36,6 +36,14 @@ public:
      * @param filePath The location of the NetCDF restart file to be read.
      */
     virtual void init(std::vector<ElementData>& dg, const std::string& filePath) const = 0;
+    /*!
+     * @brief Sets the size of the grid from the file location, without
+     * reading any data.
+     *
+     * @param filePath The location of the NetCDF restart file to be read.
+     * @return The number of ice layers of the data in the file.
+     */
+    virtual int initSize(const std::string& filePath) const = 0;
     /*!
      * @brief Writes data from the vector of data elements into the file location.
      *
@@ -13,6 +13,8 @@
 
 namespace Nextsim {
 
+class Telemetry;
+
 //! A class that controls how time steps are performed.
 class Iterator : public Logged {
 public:
@@ -64,11 +66,22 @@ public:
      */
     void parseAndSet(const std::string& startTimeStr, const std::string& stopTimeStr,
         const std::string& durationStr, const std::string& stepStr);
+    /*!
+     * @brief Sets the Telemetry to be informed of the progress of the run.
+     *
+     * @param telemetry A pointer to the Telemetry, or null for none.
+     */
+    void setTelemetry(Telemetry* telemetry);
+    //! Returns the number of time steps that run() will perform.
+    int nSteps() const;
+    //! Returns the length of each time step.
+    Duration getTimestep() const { return timestep; }
     //! Run the Iterant over the specified time period.
     void run();
 
 private:
     Iterant* iterant; // FIXME smart pointer
+    Telemetry* telemetry;
     TimePoint startTime;
     TimePoint stopTime;
     Duration timestep;
@@ -7,21 +7,178 @@
 #ifndef SRC_INCLUDE_LOGGED_HPP
 #define SRC_INCLUDE_LOGGED_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
 #include <string>
+#include <type_traits>
 
 namespace Nextsim {
 
+/*!
+ * @brief A base class providing leveled, asynchronous logging.
+ *
+ * @details Logging a message at or above the minimum level copies its
+ * arguments into a record of a ring buffer belonging to the calling thread,
+ * without locking, allocating or formatting. A background thread formats the
+ * records of all threads, in time order, and writes them to the log stream.
+ * Logging below the minimum level returns after a single comparison, before
+ * any of the arguments are converted.
+ *
+ * Each record holds up to maxArguments arguments and textCapacity characters
+ * of string arguments, beyond which the message is truncated. If the ring
+ * buffer of a thread is full the message is dropped, and the number dropped is
+ * reported in the log. Messages at ERROR or above are written before the call
+ * returns.
+ */
 class Logged {
 public:
-    enum level { INFO, DEBUG, NOTICE, WARNING, ERROR, CRITICAL, ALERT, EMERGENCY };
-    static void log(const std::string& message, const level lvl);
-    static void info(const std::string& message);
-    // TODO: functions for all the levels in between
-    static void emergency(const std::string& message);
+    //! The levels of messages, in order of increasing severity.
+    enum level { DEBUG, INFO, NOTICE, WARNING, ERROR, CRITICAL, ALERT, EMERGENCY };
+
+    //! The largest number of arguments of a message.
+    static const int maxArguments = 12;
+    //! The largest number of characters of the string arguments of a message.
+    static const int textCapacity = 160;
+
+    //! An argument of a message, of which strings are copied when enqueued.
+    class Argument {
+    public:
+        enum Type { STRING, CHARACTER, BOOLEAN, SIGNED, UNSIGNED, REAL };
+
+        Argument(const char* s)
+            : type(STRING)
+            , string(s)
+            , length(std::char_traits<char>::length(s))
+        {
+        }
+        Argument(const std::string& s)
+            : type(STRING)
+            , string(s.data())
+            , length(s.size())
+        {
+        }
+        Argument(char c)
+            : type(CHARACTER)
+            , signedValue(c)
+        {
+        }
+        Argument(bool b)
+            : type(BOOLEAN)
+            , signedValue(b)
+        {
+        }
+        template <typename T,
+            typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,
+                int>::type
+            = 0>
+        Argument(T i)
+            : type(SIGNED)
+            , signedValue(i)
+        {
+        }
+        template <typename T,
+            typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value,
+                int>::type
+            = 0>
+        Argument(T u)
+            : type(UNSIGNED)
+            , unsignedValue(u)
+        {
+        }
+        template <typename T,
+            typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+        Argument(T d)
+            : type(REAL)
+            , realValue(d)
+        {
+        }
+
+        Type type;
+        union {
+            const char* string;
+            long long signedValue;
+            unsigned long long unsignedValue;
+            double realValue;
+        };
+        size_t length = 0;
+    };
+
+    //! Logs a message of one string at the given level.
+    static void log(const std::string& message, const level lvl) { log(lvl, message); }
+
+    /*!
+     * @brief Logs a message at the given level.
+     *
+     * @details The message is the concatenation of the arguments, which may
+     * be strings, characters, booleans, integers or floating point numbers.
+     */
+    template <typename... Args> static void log(level lvl, const Args&... args)
+    {
+        if (!isEnabled(lvl))
+            return;
+        enqueue(lvl, { Argument(args)... });
+    }
+
+    template <typename... Args> static void debug(const Args&... args) { log(DEBUG, args...); }
+    template <typename... Args> static void info(const Args&... args) { log(INFO, args...); }
+    template <typename... Args> static void notice(const Args&... args) { log(NOTICE, args...); }
+    template <typename... Args> static void warning(const Args&... args) { log(WARNING, args...); }
+    template <typename... Args> static void error(const Args&... args) { log(ERROR, args...); }
+    template <typename... Args> static void critical(const Args&... args)
+    {
+        log(CRITICAL, args...);
+    }
+    template <typename... Args> static void alert(const Args&... args) { log(ALERT, args...); }
+    template <typename... Args> static void emergency(const Args&... args)
+    {
+        log(EMERGENCY, args...);
+    }
+
+    //! Returns whether messages of the given level are logged.
+    static bool isEnabled(level lvl)
+    {
+        return lvl >= s_minimumLevel.load(std::memory_order_relaxed);
+    }
+    //! Sets the level below which messages are discarded.
+    static void setMinimumLevel(level lvl) { s_minimumLevel.store(lvl); }
+    //! Returns the level below which messages are discarded.
+    static level minimumLevel() { return static_cast<level>(s_minimumLevel.load()); }
+    /*!
+     * @brief Returns the level of the given name.
+     *
+     * @details The names are the enumerators, in upper or lower case. Throws
+     * std::invalid_argument for any other name.
+     */
+    static level levelFromString(const std::string& name);
+    //! Returns the name of the given level.
+    static std::string levelName(level lvl);
+
+    /*!
+     * @brief Sets the stream the log is written to, std::cout by default.
+     *
+     * @details The messages already logged are written to the previous
+     * stream first. The stream must outlive the logging to it.
+     */
+    static void setStream(std::ostream& os);
+    //! Writes all the messages logged so far and flushes the log stream.
+    static void flush();
+    /*!
+     * @brief Sets the number of messages held by the ring buffer of each
+     * thread that logs for the first time after this call.
+     *
+     * @details The number is rounded up to a power of two.
+     */
+    static void setBufferSize(size_t nMessages);
 
 protected:
     Logged() = default;
-    // TODO: Add implementation to actually do some logging
+
+private:
+    static void enqueue(level lvl, std::initializer_list<Argument> arguments);
+
+    static std::atomic<int> s_minimumLevel;
 };
 
 } /* namespace Nextsim */
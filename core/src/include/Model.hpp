@@ -12,8 +12,12 @@
 #include "include/Configured.hpp"
 #include "include/IStructure.hpp"
 #include "include/Iterator.hpp"
+#include "include/Telemetry.hpp"
 
 #include "DevStep.hpp"
+#include <fstream>
+#include <memory>
+#include <ostream>
 #include <string>
 
 namespace Nextsim {
@@ -32,10 +36,39 @@ public:
         STOPTIME_KEY,
         RUNLENGTH_KEY,
         TIMESTEP_KEY,
+        TRACEFILE_KEY,
+        TRACEEVENTS_KEY,
+        HWCOUNTERS_KEY,
+        ALLOCATIONS_KEY,
+        TIMERREPORT_KEY,
+        PROFILEFILE_KEY,
+        PROFILEFREQUENCY_KEY,
+        PROFILESAMPLES_KEY,
+        METRICSFILE_KEY,
+        METRICSINTERVAL_KEY,
+        ROOFLINE_KEY,
+        LOGLEVEL_KEY,
+        HEALTHCHECK_KEY,
+        HEALTHCHECKCOLUMNS_KEY,
     };
 
-    //! Run the model
-    void run();
+    /*!
+     * @brief Runs the model.
+     *
+     * @details A step whose prognostic fields fail the health check stops the
+     * run. The failure is logged as critical and no restart file is written.
+     *
+     * @return false if the run stopped on a failed health check, else true.
+     */
+    bool run();
+
+    /*!
+     * @brief Reports the resources that the configured run would need,
+     * without reading or allocating any model data.
+     *
+     * @param os The ostream to write the report to.
+     */
+    void dryRun(std::ostream& os);
 
     void writeRestartFile();
 
@@ -43,13 +76,29 @@ public:
     void setFinalFilename(const std::string& finalFile);
 
 private:
+    // Sets the time parameters of the iterator from the configuration
+    void configureTime();
+
     Iterator iterator;
     DevStep modelStep; // Change the model step calculation here
 
     std::string initialFileName;
     std::string finalFileName;
+    // Chrome trace file of the timer events, if tracing is enabled
+    std::string traceFileName;
+    // JSON or CSV report of the timers, if requested
+    std::string timerReportFileName;
+    // Folded stacks of the sampling profiler, if profiling is enabled
+    std::string profileFileName;
+    int profileFrequency;
+    int profileSamples;
+    // JSON lines of the throughput of the run, if requested
+    std::ofstream metricsFile;
+    std::unique_ptr<Telemetry> telemetry;
 
     std::shared_ptr<IStructure> dataStructure;
+    // Whether the data is fit to be written to the restart file on exit
+    bool writeRestart;
 };
 
 } /* namespace Nextsim */
@@ -51,6 +51,16 @@ public:
         return m_availableImplementationNames.at(module);
     }
 
+    /*!
+     * @brief Returns the name of the implementation set for a module, or an
+     * empty string if none has been set.
+     */
+    inline std::string getImplementationName(const std::string& module) const
+    {
+        auto found = m_implementationNames.find(module);
+        return (found != m_implementationNames.end()) ? found->second : std::string();
+    }
+
     /*!
      * @brief Returns a newly created instance of the implementing class.
      *
@@ -60,6 +70,22 @@ public:
      */
     template <class T> std::unique_ptr<T> getInstance() const;
 
+    /*!
+     * @brief Returns the size of an instance of the implementing class, or
+     * zero if no implementation has been set.
+     *
+     * @details The module of interest is specified as a template argument.
+     */
+    template <class T> size_t getInstanceSize() const;
+
+    /*!
+     * @brief Returns the size of the decorator wrapping each instance of the
+     * implementing class, or zero if the instances are not decorated.
+     *
+     * @details The module of interest is specified as a template argument.
+     */
+    template <class T> size_t getDecoratorSize() const;
+
     /*!
      * @brief Returns a reference to a static instance of the implementing class.
      *
@@ -106,6 +132,8 @@ private:
     std::set<std::string> m_modules;
     // Names of available implementations
     std::map<std::string, std::list<std::string>> m_availableImplementationNames;
+    // Names of the implementations that have been set
+    std::map<std::string, std::string> m_implementationNames;
 };
 
 #endif /* SRC_INCLUDE_MODULELOADER_HPP */
@@ -0,0 +1,154 @@
+/*!
+ * @file ModuleTiming.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_MODULETIMING_HPP
+#define CORE_SRC_INCLUDE_MODULETIMING_HPP
+
+#include "Configured.hpp"
+#include "ScopedTimer.hpp"
+#include "Timer.hpp"
+
+#include <memory>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class controlling the sampled timing of module implementations.
+ *
+ * @details When the sampling interval is greater than zero, ModuleLoader
+ * returns the implementations of the timed modules wrapped in a TimedModule
+ * decorator. One in every interval calls to a decorated function is timed,
+ * together with all the calls to other decorated modules that it makes. The
+ * timers hold the sampled calls only, so the total time spent in a module is
+ * approximately its timed wall time multiplied by the interval.
+ */
+class ModuleTiming {
+public:
+    //! Returns the sampling interval, or zero if modules are not timed.
+    static int interval() { return intervalRef(); }
+    /*!
+     * @brief Sets the sampling interval.
+     *
+     * @details Only affects implementations obtained from ModuleLoader after
+     * this call.
+     *
+     * @param sampleInterval The number of calls per timed call, or zero to
+     * stop timing modules.
+     */
+    static void setInterval(int sampleInterval) { intervalRef() = sampleInterval; }
+    //! Returns whether modules are timed.
+    static bool enabled() { return interval() > 0; }
+
+    /*!
+     * @brief Times one call to a module, if it is sampled.
+     *
+     * @details The outermost decorated call on each thread decides whether it
+     * is sampled, using the call counter of its decorated function. Calls
+     * made from within it are sampled if and only if it is.
+     */
+    class Sample {
+    public:
+        /*!
+         * @brief Starts timing the call if it is sampled.
+         *
+         * @param timerId The Id of the timer of the decorated function.
+         * @param calls The per-thread call counter of the decorated function.
+         */
+        Sample(Timer::Id timerId, int& calls)
+            : p_timer(nullptr)
+        {
+            State& state = threadState();
+            if (state.depth++ == 0) {
+                state.sampling = enabled() && ++calls >= interval();
+                if (state.sampling)
+                    calls = 0;
+            }
+            if (state.sampling) {
+                p_timer = &ScopedTimer::timer();
+                p_timer->tick(timerId);
+            }
+        }
+        ~Sample()
+        {
+            if (p_timer)
+                p_timer->tock();
+            --threadState().depth;
+        }
+
+    private:
+        Timer* p_timer;
+    };
+
+private:
+    struct State {
+        int depth;
+        bool sampling;
+    };
+
+    static int& intervalRef()
+    {
+        static int sampleInterval = 0;
+        return sampleInterval;
+    }
+    static State& threadState()
+    {
+        thread_local State state = { 0, false };
+        return state;
+    }
+};
+
+/*!
+ * @brief A base class for the timing decorators of a module interface.
+ *
+ * @details A decorator forwards each function of the interface to the wrapped
+ * implementation within a ModuleTiming::Sample. It either wraps the static
+ * implementation held by ModuleLoader, or owns a new instance. Configuring the
+ * decorator configures the wrapped implementation.
+ *
+ * @tparam I The interface class of the module.
+ */
+template <class I> class TimedModule : public I, public ConfiguredBase {
+public:
+    //! Creates a decorator that does not yet wrap an implementation.
+    TimedModule()
+        : p_impl(nullptr)
+    {
+    }
+    /*!
+     * @brief Creates a decorator which owns the implementation it wraps.
+     *
+     * @param impl The implementation to be wrapped.
+     */
+    TimedModule(std::unique_ptr<I> impl)
+        : p_impl(impl.get())
+        , m_owned(std::move(impl))
+    {
+    }
+
+    //! Returns whether ModuleLoader should return decorated implementations.
+    static bool enabled() { return ModuleTiming::enabled(); }
+
+    /*!
+     * @brief Sets the implementation to be wrapped, without owning it.
+     *
+     * @param impl The implementation to be wrapped.
+     */
+    void wrap(I& impl) { p_impl = &impl; }
+    //! Returns the wrapped implementation.
+    I& wrapped() const { return *p_impl; }
+
+    void configure() override { tryConfigure(p_impl); }
+
+protected:
+    I* p_impl;
+
+private:
+    std::unique_ptr<I> m_owned;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_MODULETIMING_HPP */
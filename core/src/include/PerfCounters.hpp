@@ -0,0 +1,71 @@
+/*!
+ * @file PerfCounters.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_PERFCOUNTERS_HPP
+#define CORE_SRC_INCLUDE_PERFCOUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class providing the hardware performance counters of a thread.
+ *
+ * @details The counters are opened for the thread constructing the object
+ * using the Linux perf_event_open interface. Any counter which cannot be
+ * opened, including all counters on other systems or when the kernel does not
+ * permit access, reads as zero and is reported as unavailable. When the
+ * kernel multiplexes the counters with other events, the counts are scaled
+ * from the time the counters ran to the whole time they were enabled, and so
+ * are estimates.
+ */
+class PerfCounters {
+public:
+    //! The hardware events that are counted.
+    enum Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        N_COUNTERS,
+    };
+    //! Type of the values of all the counters.
+    typedef std::array<uint64_t, N_COUNTERS> Values;
+
+    //! Opens and starts the counters for the calling thread.
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    //! Returns whether any of the counters could be opened.
+    bool available() const { return m_groupFd >= 0; }
+    //! Returns whether the given counter could be opened.
+    bool available(Counter counter) const { return m_slot[counter] >= 0; }
+
+    /*!
+     * @brief Reads the current values of all counters.
+     *
+     * @param values The Values to be filled, with zeroes for unavailable counters.
+     */
+    void read(Values& values) const;
+
+    //! Returns the name of a counter.
+    static const char* name(Counter counter);
+
+private:
+    int m_groupFd;
+    std::array<int, N_COUNTERS> m_fd;
+    // The position of each counter in the group read, or -1 if unavailable
+    std::array<int, N_COUNTERS> m_slot;
+    int m_nOpen;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_PERFCOUNTERS_HPP */
@@ -0,0 +1,49 @@
+/*!
+ * @file Precision.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_PRECISION_HPP
+#define CORE_SRC_INCLUDE_PRECISION_HPP
+
+namespace Nextsim {
+
+//! Storage types for element fields, all held in double precision.
+struct DoublePrecision {
+    //! Storage type for the external forcing fields.
+    typedef double Forcing;
+    //! Storage type for the diagnostic fields derived from the forcing and prognostic fields.
+    typedef double Diagnostic;
+    //! Storage type for the prognostic fields and the integration of fluxes.
+    typedef double Prognostic;
+};
+
+/*!
+ * @brief Storage types for element fields, with forcing and diagnostic fields
+ * held in single precision.
+ *
+ * @details The forcing and diagnostic fields are read far more often than
+ * they are written, and the forcing data is typically single precision at
+ * source. Holding them as float halves the memory traffic of the column
+ * sweeps. Prognostic fields and accumulated fluxes remain double precision.
+ */
+struct MixedPrecision {
+    //! Storage type for the external forcing fields.
+    typedef float Forcing;
+    //! Storage type for the diagnostic fields derived from the forcing and prognostic fields.
+    typedef float Diagnostic;
+    //! Storage type for the prognostic fields and the integration of fluxes.
+    typedef double Prognostic;
+};
+
+//! The precision policy of this build, selected by NEXTSIM_MIXED_PRECISION.
+#ifdef NEXTSIM_MIXED_PRECISION
+typedef MixedPrecision Precision;
+#else
+typedef DoublePrecision Precision;
+#endif
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_PRECISION_HPP */
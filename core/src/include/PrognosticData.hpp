@@ -74,8 +74,33 @@ public:
     //! Mean snow thickness over ice [m]
     inline double snowTrueThickness() const { return (m_conc != 0) ? m_snow / m_conc : 0; }
 
-    //! Salinity dependent freezing point [˚C]
-    inline double freezingPoint() const { return (*m_freezer)(m_sss); }
+    /*!
+     * @brief Salinity dependent freezing point [˚C]
+     *
+     * @details Returns the value cached by cacheDerivedQuantities(), unless
+     * the cache has been invalidated by a change in salinity or in the
+     * freezing point implementation since it was filled.
+     */
+    inline double freezingPoint() const
+    {
+        return (m_cacheGeneration == s_freezerGeneration) ? m_tf : (*m_freezer)(m_sss);
+    }
+
+    /*!
+     * @brief Fills the cache of quantities derived from the prognostic
+     * fields.
+     *
+     * @details Should be called once per element at the start of a timestep,
+     * before the physics modules read the derived quantities. Calculation is
+     * only performed if the cache is invalid.
+     */
+    inline void cacheDerivedQuantities()
+    {
+        if (m_cacheGeneration != s_freezerGeneration) {
+            m_tf = (*m_freezer)(m_sss);
+            m_cacheGeneration = s_freezerGeneration;
+        }
+    }
 
     //! Timestep [s]
     inline double timestep() const { return m_dt; }
@@ -93,8 +118,14 @@ private:
     std::vector<double> m_tice; //!< Ice temperature [˚C]
     double m_snow; //!< Mean snow thickness [m]
 
+    double m_tf; //!< Cached freezing point [˚C]
+    //! The freezer generation that m_tf was calculated with. 0 is invalid.
+    unsigned int m_cacheGeneration;
+
     static double m_dt; //!< Current timestep, shared by all elements
     static IFreezingPoint* m_freezer;
+    //! Incremented whenever the freezing point implementation is (re)configured
+    static unsigned int s_freezerGeneration;
 
     static void copyInIceLayerData(const std::vector<double>& src, std::vector<double>& tgt);
 };
@@ -0,0 +1,59 @@
+/*!
+ * @file Roofline.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_ROOFLINE_HPP
+#define CORE_SRC_INCLUDE_ROOFLINE_HPP
+
+#include <cstddef>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class measuring the peak rates of the machine for the timer reports.
+ *
+ * @details The memory bandwidth is measured by a STREAM triad over arrays
+ * much larger than the caches, and the floating point rate by independent
+ * chains of multiply-adds held in registers. Both run on the calling thread,
+ * and the best of several repetitions is taken. The measurements are the
+ * attainable rates of a single core, against which the rates of the timers
+ * reported by Timer::addWork() can be compared.
+ */
+class Roofline {
+public:
+    //! The default number of doubles in each array of the bandwidth probe
+    static const size_t defaultArraySize = 1 << 23;
+    //! The default number of repetitions of each probe
+    static const int defaultRepeats = 5;
+
+    /*!
+     * @brief Measures the memory bandwidth.
+     *
+     * @param arraySize The number of doubles in each of the three arrays.
+     * @param repeats The number of repetitions, the fastest of which is used.
+     * @return The bandwidth [B s⁻¹].
+     */
+    static double bandwidth(size_t arraySize = defaultArraySize, int repeats = defaultRepeats);
+
+    /*!
+     * @brief Measures the floating point rate.
+     *
+     * @param iterations The number of iterations of each chain of multiply-adds.
+     * @param repeats The number of repetitions, the fastest of which is used.
+     * @return The floating point operations per second [s⁻¹].
+     */
+    static double flopRate(long iterations = 1 << 24, int repeats = defaultRepeats);
+
+    /*!
+     * @brief Measures both peak rates and sets them in Timer::setPeak().
+     *
+     * @param arraySize The number of doubles in each array of the bandwidth probe.
+     */
+    static void measure(size_t arraySize = defaultArraySize);
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_ROOFLINE_HPP */
@@ -0,0 +1,87 @@
+/*!
+ * @file Sampler.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_SAMPLER_HPP
+#define CORE_SRC_INCLUDE_SAMPLER_HPP
+
+#include "Timer.hpp"
+
+#include <cstddef>
+#include <ostream>
+
+namespace Nextsim {
+
+/*!
+ * @brief A statistical profiler attributing samples to the running timers.
+ *
+ * @details While running, the process receives SIGPROF at the given
+ * frequency of consumed CPU time. Each signal records, in a buffer belonging
+ * to the interrupted thread, the path of the running timer of that thread
+ * (see ScopedTimer::timerAddress()) and a shallow backtrace of the
+ * interrupted code. Recording takes no locks and does not allocate. The
+ * samples can then be written as folded stacks, the input of flame graph
+ * tools. Sampling is only available on Linux.
+ *
+ * Each sampled thread claims one of a fixed number of buffers on its first
+ * sample, and only then is the memory of its samples allocated. Samples from
+ * threads which find no free buffer, or whose buffer is full, are counted as
+ * dropped.
+ */
+class Sampler {
+public:
+    //! Default sampling frequency [Hz]
+    static const int defaultFrequency = 100;
+    //! Default number of samples each thread can hold, 40 s of CPU time at 100 Hz
+    static const size_t defaultSamples = 4096;
+    //! The maximum number of sampled threads
+    static const int maxThreads = 64;
+    //! The maximum depth of the recorded timer paths
+    static const int maxTimerDepth = 16;
+    //! The number of frames of the recorded backtraces
+    static const int maxFrames = 8;
+
+    /*!
+     * @brief Starts sampling, discarding any previous samples.
+     *
+     * @param frequency The number of samples per second of CPU time.
+     * @param samplesPerThread The number of samples that each thread can hold.
+     * @return Whether sampling could be started.
+     */
+    static bool start(int frequency = defaultFrequency, size_t samplesPerThread = defaultSamples);
+    //! Stops sampling, keeping the recorded samples.
+    static void stop();
+    //! Returns whether sampling is running.
+    static bool isRunning();
+
+    //! Returns the number of samples recorded by all threads.
+    static size_t samples();
+    //! Returns the number of samples which could not be recorded.
+    static size_t dropped();
+
+    /*!
+     * @brief Writes the recorded samples as folded stacks.
+     *
+     * @details Each line holds the names of the timers of one timer path,
+     * followed by the functions of the backtrace from the outermost to the
+     * interrupted one, separated by semicolons, and then the number of
+     * samples with that stack. Samples taken outside any timer begin with
+     * "[untimed]". Functions are named where the dynamic symbol table allows,
+     * otherwise they are written as an offset into their object file. This
+     * must not be called while sampling is running.
+     *
+     * @param os The ostream to write to.
+     */
+    static std::ostream& writeFolded(std::ostream& os);
+
+private:
+    // Fills the path of the running timer of the calling thread, returning its depth
+    static int runningTimerPath(Timer::Id* path);
+    friend void sampleHandler(int);
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_SAMPLER_HPP */
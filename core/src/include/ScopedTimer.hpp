@@ -16,16 +16,25 @@
 
 namespace Nextsim {
 
-//! A class providing a timer aware of the calling context
+/*!
+ * @brief A class providing a timer aware of the calling context
+ *
+ * @details Each thread times into its own Timer. A thread which has not set a
+ * timer address uses Timer::threadTimer(), which can be merged into the main
+ * timer with Timer::mergeThreadTimers().
+ */
 class ScopedTimer {
 public:
     ScopedTimer();
     //! Creates a scoped timer with a name
     ScopedTimer(const std::string& name);
+    //! Creates a scoped timer from an interned timer Id
+    ScopedTimer(Timer::Id timerId) { timer().tick(timerId); }
     ~ScopedTimer();
 
     /*!
-     * Sets the address of the timer which provides the timing functions
+     * Sets the address of the timer which provides the timing functions on
+     * the calling thread
      *
      * @param timer A pointer to an instance of the Timer class.
      */
@@ -37,11 +46,29 @@ public:
      * @param newName the name of the new timer
      */
     void substitute(const std::string& newName);
-    //! Returns a reference to the underlying Timer.
-    static Timer& timer();
+    /*!
+     * Substitutes the currently running timer with a new one with a
+     * different interned Id.
+     *
+     * @param newId the Id of the new timer
+     */
+    void substitute(Timer::Id newId)
+    {
+        p_timer->tock();
+        p_timer->tick(newId);
+    }
+    //! Returns a reference to the underlying Timer of the calling thread.
+    static Timer& timer()
+    {
+        if (!p_timer)
+            p_timer = &Timer::threadTimer();
+        return *p_timer;
+    }
+    //! Returns the Timer of the calling thread, or null if it has not yet been set.
+    static Timer* timerAddress() { return p_timer; }
 
 private:
-    static Timer* p_timer;
+    static thread_local Timer* p_timer;
 };
 
 } /* namespace Nextsim */
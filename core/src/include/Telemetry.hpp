@@ -0,0 +1,105 @@
+/*!
+ * @file Telemetry.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_TELEMETRY_HPP
+#define CORE_SRC_INCLUDE_TELEMETRY_HPP
+
+#include "Iterator.hpp"
+#include "Timer.hpp"
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class writing the throughput of the model as it runs.
+ *
+ * @details Every given number of time steps, and at the end of the run, one
+ * line of JSON is written holding the throughput since the previous line: the
+ * simulated days and years per wall clock day, the columns processed per
+ * second and the share of the wall time spent in each child timer of the
+ * step timer. It also holds the estimated wall time to reach the stop time at
+ * that rate. The final line holds the throughput of the whole run. The
+ * columns are those counted by Timer::countItems() in the column timer.
+ */
+class Telemetry {
+public:
+    typedef Iterator::TimePoint TimePoint;
+
+    /*!
+     * @brief Creates a Telemetry writing to an ostream.
+     *
+     * @param os The ostream to write to.
+     * @param interval The number of time steps between lines, or zero to only
+     * write the final line.
+     * @param timer The Timer holding the step and column timers.
+     */
+    Telemetry(std::ostream& os, int interval, const Timer& timer = Timer::main);
+
+    /*!
+     * @brief Sets the name of the timer of each time step.
+     *
+     * @param timerName The name of the timer, "DevStep" by default.
+     */
+    void setStepTimer(const Timer::Key& timerName) { m_stepTimer = timerName; }
+    /*!
+     * @brief Sets the name of the timer which counts the processed columns.
+     *
+     * @param timerName The name of the timer, "column physics" by default.
+     */
+    void setColumnTimer(const Timer::Key& timerName) { m_columnTimer = timerName; }
+
+    /*!
+     * @brief Starts measuring the throughput.
+     *
+     * @param startTime The model time at the start of the run.
+     * @param stopTime The model time at the end of the run.
+     */
+    void start(TimePoint startTime, TimePoint stopTime);
+    /*!
+     * @brief Records the completion of a time step.
+     *
+     * @param modelTime The model time at the end of the step.
+     */
+    void step(TimePoint modelTime);
+    /*!
+     * @brief Writes the throughput of the whole run.
+     *
+     * @param modelTime The model time at the end of the run.
+     */
+    void finish(TimePoint modelTime);
+
+private:
+    // Cumulative quantities at one point in the run
+    struct Sample {
+        std::chrono::steady_clock::time_point wall;
+        TimePoint modelTime;
+        int steps;
+        long columns;
+        std::map<Timer::Key, double> phases;
+    };
+
+    Sample measure(TimePoint modelTime) const;
+    void write(const Sample& now, const Sample& since, bool final);
+
+    std::ostream& m_os;
+    int m_interval;
+    const Timer& m_timer;
+    Timer::Key m_stepTimer;
+    Timer::Key m_columnTimer;
+
+    TimePoint m_stopTime;
+    int m_steps;
+    Sample m_start;
+    Sample m_previous;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_TELEMETRY_HPP */
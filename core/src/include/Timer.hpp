@@ -7,22 +7,36 @@
 #ifndef SRC_INCLUDE_TIMER_HPP
 #define SRC_INCLUDE_TIMER_HPP
 
+#include "AllocationCounter.hpp"
 #include "Chrono.hpp"
+#include "PerfCounters.hpp"
 
 #include <chrono>
+#include <csignal>
 #include <ctime>
 #include <forward_list>
-#include <map>
+#include <memory>
 #include <ostream>
-#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace Nextsim {
 
-//! A class for a hierarchical timer functions.
+/*!
+ * @brief A class for a hierarchical timer functions.
+ *
+ * @details Timer names are interned as integer Ids. Starting and stopping a
+ * timer by Id involves no string handling, so the Id of a frequently used
+ * timer should be obtained once with Timer::id() and reused. The cost of a
+ * tick and tock pair is calibrated and subtracted from the reported times of
+ * the enclosing timers.
+ */
 class Timer {
 public:
     typedef std::string Key;
+    //! Type of an interned timer name.
+    typedef unsigned int Id;
 
     typedef Chrono::WallTimePoint WallTimePoint;
     typedef Chrono::WallTimeDuration WallTimeDuration;
@@ -41,33 +55,151 @@ public:
     Timer(const Key& rootKey);
     virtual ~Timer() = default;
 
+    /*!
+     * @brief Returns the interned Id of a timer name, creating it if necessary.
+     *
+     * @param timerName The name of the timer.
+     */
+    static Id id(const Key& timerName);
+    /*!
+     * @brief Finds the interned Id of a timer name without creating it.
+     *
+     * @param timerName The name of the timer.
+     * @param timerId Set to the Id of the timer, if the name is interned.
+     * @return Whether the name has been interned.
+     */
+    static bool findId(const Key& timerName, Id& timerId);
+    /*!
+     * @brief Returns the timer name of an interned Id.
+     *
+     * @param timerId The Id of the timer.
+     */
+    static const Key& name(Id timerId);
+
     /*!
      * @brief Starts a named timer.
      *
      * @param timerName Name of the timer to be started.
      */
-    void tick(const Key& timerName);
+    void tick(const Key& timerName) { tick(id(timerName)); }
+    /*!
+     * @brief Starts a timer identified by its interned Id.
+     *
+     * @param timerId Id of the timer to be started.
+     */
+    void tick(Id timerId)
+    {
+        current = childNode(current, timerId);
+        TimerNode& node = nodes[current];
+        if (perfCounters)
+            perfCounters->read(node.countersAtStart);
+        if (countingAllocations)
+            node.allocationsAtStart = AllocationCounter::threadCounts();
+        node.timeKeeper.start();
+        if (!traceEvents.empty())
+            recordEvent(timerId, true, node.timeKeeper.wallHack());
+    }
     /*!
      * @brief Stops a named timer.
      *
-     * @param timerName Name of the timer to be stopped.
+     * @details The name only documents the call: the last timer to be
+     * started is stopped.
+     */
+    void tock(const Key&) { tock(); }
+    /*!
+     * @brief Stops a timer identified by its interned Id.
+     *
+     * @details The Id only documents the call: the last timer to be started
+     * is stopped.
      */
-    void tock(const Key& timerName);
+    void tock(Id) { tock(); }
     //! @brief Stop the last timer to be started.
-    void tock();
+    void tock()
+    {
+        TimerNode& node = nodes[current];
+        node.timeKeeper.stop();
+        if (perfCounters)
+            accumulateCounters(node);
+        if (countingAllocations)
+            accumulateAllocations(node);
+        if (!traceEvents.empty())
+            recordEvent(node.id, false, std::chrono::steady_clock::now());
+        current = node.parent;
+    }
+
+    /*!
+     * @brief Adds to the number of items processed by the running timer.
+     *
+     * @details The hardware event counts of the timer are also reported per
+     * item, for example per column of the physics.
+     *
+     * @param items The number of additional items.
+     */
+    void countItems(long items) { nodes[current].items += items; }
+
+    /*!
+     * @brief Adds to the work done by the running timer.
+     *
+     * @details The achieved memory bandwidth and floating point rate of the
+     * timer are reported, also as percentages of the peak rates given to
+     * setPeak().
+     *
+     * @param bytes The number of additional bytes read and written.
+     * @param flops The number of additional floating point operations.
+     */
+    void addWork(double bytes, double flops)
+    {
+        nodes[current].bytes += bytes;
+        nodes[current].flops += flops;
+    }
+    /*!
+     * @brief Sets the peak rates of the machine for the reports of work.
+     *
+     * @param bytesPerSecond The peak memory bandwidth [B s⁻¹].
+     * @param flopsPerSecond The peak floating point rate [s⁻¹].
+     */
+    static void setPeak(double bytesPerSecond, double flopsPerSecond);
 
     /*!
      * @brief Returns the elapsed time without stopping the timer.
      *
+     * @details The wall time in seconds since the first timer with the given
+     * name was last started, or zero if it is not running. Throws
+     * std::out_of_range if there is no such timer.
+     *
      * @param timerName the name of the timer to interrogate.
      */
     double lap(const Key& timerName) const;
     /*!
      * @brief Returns the elapsed time.
      *
+     * @details The total wall time in seconds of all activations of the first
+     * timer with the given name, including any current activation. Throws
+     * std::out_of_range if there is no such timer.
+     *
      * @param timerName the name of the timer to interrogate.
      */
     double elapsed(const Key& timerName) const;
+    /*!
+     * @brief Returns the number of items processed.
+     *
+     * @details The items counted by countItems() in all activations of the
+     * first timer with the given name. Throws std::out_of_range if there is no
+     * such timer.
+     *
+     * @param timerName the name of the timer to interrogate.
+     */
+    long items(const Key& timerName) const;
+    /*!
+     * @brief Returns the names of the child timers.
+     *
+     * @details The children of the first timer with the given name, in the
+     * order they were first started. Throws std::out_of_range if there is no
+     * such timer.
+     *
+     * @param timerName the name of the timer to interrogate.
+     */
+    std::vector<Key> children(const Key& timerName) const;
 
     /*!
      * @brief Prints the status of a named timer to an ostream.
@@ -90,6 +222,42 @@ public:
      */
     std::ostream& report(const TimerPath&, std::ostream& os) const;
 
+    /*!
+     * @brief Writes all the timers to an ostream as JSON.
+     *
+     * @details Each timer is an object holding its name and the values named
+     * by reportColumns(), with its child timers in an array named "children".
+     *
+     * @param os The ostream to write to.
+     */
+    std::ostream& reportJSON(std::ostream& os) const;
+    /*!
+     * @brief Writes all the timers to an ostream as CSV.
+     *
+     * @details The first line names the columns. Each following line is one
+     * timer. Its first column is the path of the timer, the names of the timer
+     * and its ancestors separated by '/'. The remaining columns are the values
+     * named by reportColumns().
+     *
+     * @param os The ostream to write to.
+     */
+    std::ostream& reportCSV(std::ostream& os) const;
+    //! Returns the names of the values of each timer in the JSON and CSV reports.
+    static const std::vector<std::string>& reportColumns();
+    //! Quotes a field of a CSV report if it contains a separator, quote or line break.
+    static std::string csvField(const std::string& field)
+    {
+        if (field.find_first_of(",\"\n\r") == std::string::npos)
+            return field;
+        std::string quoted = "\"";
+        for (char c : field) {
+            if (c == '"')
+                quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
     /*!
      * @brief Adds an additional time increment to a timer.
      *
@@ -105,31 +273,191 @@ public:
 
     //! Deletes all timers except the root, which is reset.
     void reset();
+
+    /*!
+     * @brief Measures the overhead of a tick and tock pair.
+     *
+     * @details The overhead is subtracted from the reported time of a timer
+     * once for each activation of its descendants. Reports calibrate the
+     * overhead on first use if this has not been called.
+     */
+    static WallTimeDuration calibrate();
+    //! Returns the calibrated overhead of a tick and tock pair.
+    static WallTimeDuration overhead();
+
+    /*!
+     * @brief Returns the Timer of the calling thread.
+     *
+     * @details The first call on each thread creates a Timer for that thread
+     * and registers it, so that it can later be merged with
+     * mergeThreadTimers(). Only the calling thread should start or stop
+     * timers on the returned Timer.
+     */
+    static Timer& threadTimer();
+    /*!
+     * @brief Merges the per-thread timers into this Timer.
+     *
+     * @details The timers of each registered thread are added below the
+     * currently running timer of this Timer, which then also holds the
+     * minimum, maximum and mean wall time across threads of each merged
+     * timer. The thread timers are reset after merging. This must not be
+     * called while any other thread is timing.
+     */
+    void mergeThreadTimers();
+
+    /*!
+     * @brief Starts or stops recording the start and stop events of timers.
+     *
+     * @details Applies to Timer::main and to all thread timers. Each records
+     * its events in a ring buffer of the given size, allocated here or when
+     * the thread timer is created, so only the most recent events are kept.
+     *
+     * @param eventsPerTimer The number of events that each Timer can hold,
+     * or zero to stop recording.
+     */
+    static void enableTracing(size_t eventsPerTimer);
+    /*!
+     * @brief Writes the recorded events in the Chrome trace event format.
+     *
+     * @details Events of Timer::main are written as thread 0, those of the
+     * thread timers as subsequent threads. The output can be viewed with
+     * Perfetto or chrome://tracing. This must not be called while any other
+     * thread is timing.
+     *
+     * @param os The ostream to write to.
+     */
+    static std::ostream& writeTrace(std::ostream& os);
+
+    /*!
+     * @brief Starts or stops counting hardware events in the timers.
+     *
+     * @details Applies to Timer::main, which counts the events of the calling
+     * thread, and to thread timers created after this call. The cycles,
+     * instructions, last level cache misses and branch misses are reported for
+     * each timer.
+     *
+     * @param enable true to count hardware events, false to stop counting.
+     * @return Whether any hardware counters are available to Timer::main.
+     */
+    static bool enableHardwareCounters(bool enable);
+
+    /*!
+     * @brief Starts or stops counting heap allocations in the timers.
+     *
+     * @details Applies to Timer::main and to thread timers created after this
+     * call. The number of allocations and bytes allocated between the start
+     * and stop of each timer, and the peak resident set size of the process
+     * when it stopped, are reported for each timer. Allocations are only
+     * counted in executables which link AllocationCounter.cpp.
+     *
+     * @param enable true to count allocations, false to stop counting.
+     * @return Whether allocations can be counted.
+     */
+    static bool enableAllocationCounting(bool enable);
+    //! Returns the peak resident set size of the process [kB].
+    static long peakResidentSize();
+
     //! Static timer for general use.
     static Timer main;
 
 private:
+    // Reads the running timer path of the interrupted thread
+    friend class Sampler;
+
     struct TimerNode {
-        TimerNode();
-        Key name;
+        TimerNode(Id nodeId, int parentIndex);
+        Id id;
 
         Chrono timeKeeper;
 
-        std::map<Key, TimerNode> childNodes;
-        TimerNode* parent;
+        // Pairs of the Id and the index of each child node
+        std::vector<std::pair<Id, int>> childNodes;
+        int parent;
+
+        // Hardware event counts and processed items
+        PerfCounters::Values countersAtStart;
+        PerfCounters::Values counters;
+        long items;
+
+        // Declared memory traffic and floating point operations
+        double bytes;
+        double flops;
 
-        void tick();
-        void tock();
-        std::ostream& report(std::ostream& os, const std::string& prefix) const;
-        std::ostream& reportAll(std::ostream& os, const std::string& prefix) const;
+        // Heap allocations and the peak resident set size
+        AllocationCounter::Counts allocationsAtStart;
+        AllocationCounter::Counts allocations;
+        long peakResident;
 
-        TimerPath searchDescendants(const Key& timerName) const;
+        // Wall time statistics across merged thread timers
+        int threadCount;
+        WallTimeDuration threadMin;
+        WallTimeDuration threadMax;
+        WallTimeDuration threadSum;
     };
 
+    struct TraceEvent {
+        Id id;
+        bool begin;
+        WallTimePoint time;
+    };
+
+    inline void recordEvent(Id timerId, bool begin, WallTimePoint time)
+    {
+        TraceEvent& event = traceEvents[traceNext];
+        event.id = timerId;
+        event.begin = begin;
+        event.time = time;
+        if (++traceNext == traceEvents.size()) {
+            traceNext = 0;
+            traceWrapped = true;
+        }
+    }
+    void setTraceCapacity(size_t capacity);
+    void accumulateCounters(TimerNode& node);
+    void accumulateAllocations(TimerNode& node);
+    std::ostream& writeTraceEvents(std::ostream& os, int tid, bool& first) const;
+
+    // Returns the index of a child of a node, creating it if necessary
+    inline int childNode(int parentIndex, Id childId)
+    {
+        for (auto& child : nodes[parentIndex].childNodes) {
+            if (child.first == childId)
+                return child.second;
+        }
+        return addNode(parentIndex, childId);
+    }
+    int addNode(int parentIndex, Id childId);
+
+    int descendantTicks(int node) const;
+    WallTimeDuration correctedWallTime(int node) const;
+    bool searchDescendants(int node, Id timerId, TimerPath& path) const;
+    int findNode(int node, Id timerId) const;
+    int findNode(const Key& timerName) const;
+    std::vector<double> reportValues(int node) const;
+    std::ostream& reportJSON(int node, std::ostream& os, const std::string& indent) const;
+    std::ostream& reportCSV(int node, std::ostream& os, const std::string& parentPath) const;
+    void mergeNode(int targetParent, Timer& source, int sourceNode);
+    std::ostream& report(int node, std::ostream& os, const std::string& prefix) const;
+    std::ostream& reportAll(int node, std::ostream& os, const std::string& prefix) const;
+
     TimerPath pathToFirstMatch(const Key&) const;
 
-    TimerNode root;
-    TimerNode* current;
+    // The timer nodes, the first of which is the root
+    std::vector<TimerNode> nodes;
+    int current;
+    // Non-zero while nodes are added or removed, when they must not be read by a signal handler
+    volatile std::sig_atomic_t restructuring;
+
+    // Hardware counters of the thread using this Timer, null when not counting
+    std::unique_ptr<PerfCounters> perfCounters;
+    bool countingAllocations;
+
+    // Ring buffer of start and stop events, empty when not tracing
+    std::vector<TraceEvent> traceEvents;
+    size_t traceNext;
+    bool traceWrapped;
+
+    static const int root = 0;
 };
 
 } /* namespace Nextsim */
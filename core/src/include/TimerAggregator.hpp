@@ -0,0 +1,86 @@
+/*!
+ * @file TimerAggregator.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef CORE_SRC_INCLUDE_TIMERAGGREGATOR_HPP
+#define CORE_SRC_INCLUDE_TIMERAGGREGATOR_HPP
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class combining the CSV timer reports of several processes.
+ *
+ * @details Each report is read in the format written by Timer::reportCSV().
+ * For each timer path and each value of the report, the minimum, maximum and
+ * mean across the reports containing that timer are calculated. This is
+ * intended for combining the reports of the ranks of a parallel run, or of the
+ * runs of a scaling study.
+ */
+class TimerAggregator {
+public:
+    //! Statistics of one value of one timer across reports.
+    struct Statistics {
+        int count;
+        double min;
+        double max;
+        double sum;
+        //! The mean of the value, or zero if there are no reports.
+        double mean() const { return count ? sum / count : 0; }
+    };
+
+    TimerAggregator();
+    ~TimerAggregator() = default;
+
+    /*!
+     * @brief Adds a CSV timer report.
+     *
+     * @details Throws std::invalid_argument if the columns of the report
+     * differ from those of the previously added reports.
+     *
+     * @param is The istream to read the report from.
+     */
+    void addCSV(std::istream& is);
+
+    //! Returns the number of reports added.
+    int reports() const { return m_reports; }
+    //! Returns the timer paths, in the order they were first found.
+    const std::vector<std::string>& paths() const { return m_paths; }
+
+    /*!
+     * @brief Returns the statistics of one value of one timer.
+     *
+     * @details Throws std::out_of_range if the path or column is unknown.
+     *
+     * @param path The path of the timer.
+     * @param column The name of the value.
+     */
+    const Statistics& statistics(const std::string& path, const std::string& column) const;
+
+    /*!
+     * @brief Writes the statistics as CSV.
+     *
+     * @details Each line holds the timer path, the number of reports
+     * containing it and the minimum, maximum and mean of each value.
+     *
+     * @param os The ostream to write to.
+     */
+    std::ostream& writeCSV(std::ostream& os) const;
+
+private:
+    std::vector<std::string> m_columns;
+    std::vector<std::string> m_paths;
+    std::map<std::string, std::vector<Statistics>> m_statistics;
+    int m_reports;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_TIMERAGGREGATOR_HPP */
@@ -28,10 +28,13 @@ int main(int argc, char* argv[])
 
     // Construct the Model
     Nextsim::Model model;
+    if (cmdLine.isDryRun()) {
+        // Report the resources the run would need, without loading any data
+        model.dryRun(std::cout);
+        return 0;
+    }
     // Apply the model configuration
     model.configure();
-    // Run the Model
-    model.run();
-
-    return 0;
+    // Run the Model, failing if the model state fails its health check
+    return model.run() ? 0 : 1;
 }
@@ -9,6 +9,7 @@
 #include "include/ElementData.hpp"
 
 #include <cstddef>
+#include <stdexcept>
 #include <vector>
 
 namespace Nextsim {
@@ -17,18 +18,34 @@ const std::string DevGrid::structureName = "devgrid";
 const std::string DevGrid::xDimName = "x";
 const std::string DevGrid::yDimName = "y";
 const std::string DevGrid::nIceLayersName = "nLayers";
-const int DevGrid::nx = 10;
+const int DevGrid::defaultNx = 10;
 
 void DevGrid::init(const std::string& filePath)
 {
     ElementData configureMe;
     configureMe.configure();
-    data.resize(nx * nx);
+    data.resize(m_nx * m_ny);
     if (pio && !filePath.empty()) {
         pio->init(data, filePath);
     }
 };
 
+int DevGrid::initSize(const std::string& filePath)
+{
+    if (!pio)
+        throw std::logic_error("DevGrid::initSize: no IO has been set");
+    return pio->initSize(filePath);
+}
+
+void DevGrid::resize(int nx, int ny)
+{
+    if (nx <= 0 || ny <= 0)
+        throw std::invalid_argument("DevGrid::resize: the grid must have at least one element");
+    m_nx = nx;
+    m_ny = ny;
+    data.resize(m_nx * m_ny);
+}
+
 void DevGrid::dump(const std::string& filePath) const
 {
     if (pio && !filePath.empty()) {
@@ -47,4 +64,11 @@ ElementData& DevGrid::cursorData() { return *iCursor; }
 const ElementData& DevGrid::cursorData() const { return *iCursor; }
 void DevGrid::incrCursor() { ++iCursor; }
 
+bool DevGrid::contiguousData(ElementData*& first, ElementData*& last)
+{
+    first = data.data();
+    last = first + data.size();
+    return true;
+}
+
 } /* namespace Nextsim */
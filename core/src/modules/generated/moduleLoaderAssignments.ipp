@@ -0,0 +1,76 @@
+        if (module == "Nextsim::IFreezingPoint") {
+            if (impl == "Nextsim::LinearFreezing") {
+                p_IFreezingPoint = &i_LinearFreezing;
+                pf_IFreezingPoint = &newLinearFreezing;
+                s_IFreezingPoint = sizeof(Nextsim::LinearFreezing);
+            } else if (impl == "Nextsim::UnescoFreezing") {
+                p_IFreezingPoint = &i_UnescoFreezing;
+                pf_IFreezingPoint = &newUnescoFreezing;
+                s_IFreezingPoint = sizeof(Nextsim::UnescoFreezing);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IStructure") {
+            if (impl == "Nextsim::DevGrid") {
+                p_IStructure = &i_DevGrid;
+                pf_IStructure = &newDevGrid;
+                s_IStructure = sizeof(Nextsim::DevGrid);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IIceAlbedo") {
+            if (impl == "Nextsim::SMUIceAlbedo") {
+                p_IIceAlbedo = &i_SMUIceAlbedo;
+                pf_IIceAlbedo = &newSMUIceAlbedo;
+                s_IIceAlbedo = sizeof(Nextsim::SMUIceAlbedo);
+            } else if (impl == "Nextsim::SMU2IceAlbedo") {
+                p_IIceAlbedo = &i_SMU2IceAlbedo;
+                pf_IIceAlbedo = &newSMU2IceAlbedo;
+                s_IIceAlbedo = sizeof(Nextsim::SMU2IceAlbedo);
+            } else if (impl == "Nextsim::CCSMIceAlbedo") {
+                p_IIceAlbedo = &i_CCSMIceAlbedo;
+                pf_IIceAlbedo = &newCCSMIceAlbedo;
+                s_IIceAlbedo = sizeof(Nextsim::CCSMIceAlbedo);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IIceOceanHeatFlux") {
+            if (impl == "Nextsim::BasicIceOceanHeatFlux") {
+                p_IIceOceanHeatFlux = &i_BasicIceOceanHeatFlux;
+                pf_IIceOceanHeatFlux = &newBasicIceOceanHeatFlux;
+                s_IIceOceanHeatFlux = sizeof(Nextsim::BasicIceOceanHeatFlux);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IConcentrationModel") {
+            if (impl == "Nextsim::HiblerConcentration") {
+                p_IConcentrationModel = &i_HiblerConcentration;
+                pf_IConcentrationModel = &newHiblerConcentration;
+                s_IConcentrationModel = sizeof(Nextsim::HiblerConcentration);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IThermodynamics") {
+            if (impl == "Nextsim::ThermoIce0") {
+                p_IThermodynamics = &i_ThermoIce0;
+                pf_IThermodynamics = &newThermoIce0;
+                s_IThermodynamics = sizeof(Nextsim::ThermoIce0);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else if (module == "Nextsim::IPhysics1d") {
+            if (impl == "Nextsim::NextsimPhysics") {
+                p_IPhysics1d = &i_NextsimPhysics;
+                pf_IPhysics1d = &newNextsimPhysics;
+                s_IPhysics1d = sizeof(Nextsim::NextsimPhysics);
+            } else {
+                throwup(module, impl);
+            }
+
+        } else { }
\ No newline at end of file
@@ -0,0 +1,266 @@
+static Nextsim::IFreezingPoint* p_IFreezingPoint;
+static size_t s_IFreezingPoint;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IFreezingPoint>() const
+{
+    return s_IFreezingPoint;
+}
+static Nextsim::TimedFreezingPoint d_IFreezingPoint;
+template<>
+Nextsim::IFreezingPoint& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedFreezingPoint::enabled()) {
+        d_IFreezingPoint.wrap(*p_IFreezingPoint);
+        return d_IFreezingPoint;
+    }
+    return *p_IFreezingPoint;
+}
+std::unique_ptr<Nextsim::IFreezingPoint> (*pf_IFreezingPoint)();
+template<>
+std::unique_ptr<Nextsim::IFreezingPoint> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedFreezingPoint::enabled()) {
+        return std::unique_ptr<Nextsim::IFreezingPoint>(new Nextsim::TimedFreezingPoint((*pf_IFreezingPoint)()));
+    }
+    return (*pf_IFreezingPoint)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IFreezingPoint>() const
+{
+    return Nextsim::TimedFreezingPoint::enabled() ? sizeof(Nextsim::TimedFreezingPoint) : 0;
+}
+static Nextsim::LinearFreezing i_LinearFreezing;
+std::unique_ptr<Nextsim::IFreezingPoint> newLinearFreezing()
+{
+    return std::unique_ptr<Nextsim::LinearFreezing>(new Nextsim::LinearFreezing);
+}
+static Nextsim::UnescoFreezing i_UnescoFreezing;
+std::unique_ptr<Nextsim::IFreezingPoint> newUnescoFreezing()
+{
+    return std::unique_ptr<Nextsim::UnescoFreezing>(new Nextsim::UnescoFreezing);
+}
+
+static Nextsim::IStructure* p_IStructure;
+static size_t s_IStructure;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IStructure>() const
+{
+    return s_IStructure;
+}
+template<>
+Nextsim::IStructure& ModuleLoader::getImplementation()
+{
+    return *p_IStructure;
+}
+std::unique_ptr<Nextsim::IStructure> (*pf_IStructure)();
+template<>
+std::unique_ptr<Nextsim::IStructure> ModuleLoader::getInstance() const
+{
+    return (*pf_IStructure)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IStructure>() const
+{
+    return 0;
+}
+static Nextsim::DevGrid i_DevGrid;
+std::unique_ptr<Nextsim::IStructure> newDevGrid()
+{
+    return std::unique_ptr<Nextsim::DevGrid>(new Nextsim::DevGrid);
+}
+
+static Nextsim::IIceAlbedo* p_IIceAlbedo;
+static size_t s_IIceAlbedo;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IIceAlbedo>() const
+{
+    return s_IIceAlbedo;
+}
+static Nextsim::TimedIceAlbedo d_IIceAlbedo;
+template<>
+Nextsim::IIceAlbedo& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedIceAlbedo::enabled()) {
+        d_IIceAlbedo.wrap(*p_IIceAlbedo);
+        return d_IIceAlbedo;
+    }
+    return *p_IIceAlbedo;
+}
+std::unique_ptr<Nextsim::IIceAlbedo> (*pf_IIceAlbedo)();
+template<>
+std::unique_ptr<Nextsim::IIceAlbedo> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedIceAlbedo::enabled()) {
+        return std::unique_ptr<Nextsim::IIceAlbedo>(new Nextsim::TimedIceAlbedo((*pf_IIceAlbedo)()));
+    }
+    return (*pf_IIceAlbedo)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IIceAlbedo>() const
+{
+    return Nextsim::TimedIceAlbedo::enabled() ? sizeof(Nextsim::TimedIceAlbedo) : 0;
+}
+static Nextsim::SMUIceAlbedo i_SMUIceAlbedo;
+std::unique_ptr<Nextsim::IIceAlbedo> newSMUIceAlbedo()
+{
+    return std::unique_ptr<Nextsim::SMUIceAlbedo>(new Nextsim::SMUIceAlbedo);
+}
+static Nextsim::SMU2IceAlbedo i_SMU2IceAlbedo;
+std::unique_ptr<Nextsim::IIceAlbedo> newSMU2IceAlbedo()
+{
+    return std::unique_ptr<Nextsim::SMU2IceAlbedo>(new Nextsim::SMU2IceAlbedo);
+}
+static Nextsim::CCSMIceAlbedo i_CCSMIceAlbedo;
+std::unique_ptr<Nextsim::IIceAlbedo> newCCSMIceAlbedo()
+{
+    return std::unique_ptr<Nextsim::CCSMIceAlbedo>(new Nextsim::CCSMIceAlbedo);
+}
+
+static Nextsim::IIceOceanHeatFlux* p_IIceOceanHeatFlux;
+static size_t s_IIceOceanHeatFlux;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IIceOceanHeatFlux>() const
+{
+    return s_IIceOceanHeatFlux;
+}
+static Nextsim::TimedIceOceanHeatFlux d_IIceOceanHeatFlux;
+template<>
+Nextsim::IIceOceanHeatFlux& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedIceOceanHeatFlux::enabled()) {
+        d_IIceOceanHeatFlux.wrap(*p_IIceOceanHeatFlux);
+        return d_IIceOceanHeatFlux;
+    }
+    return *p_IIceOceanHeatFlux;
+}
+std::unique_ptr<Nextsim::IIceOceanHeatFlux> (*pf_IIceOceanHeatFlux)();
+template<>
+std::unique_ptr<Nextsim::IIceOceanHeatFlux> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedIceOceanHeatFlux::enabled()) {
+        return std::unique_ptr<Nextsim::IIceOceanHeatFlux>(new Nextsim::TimedIceOceanHeatFlux((*pf_IIceOceanHeatFlux)()));
+    }
+    return (*pf_IIceOceanHeatFlux)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IIceOceanHeatFlux>() const
+{
+    return Nextsim::TimedIceOceanHeatFlux::enabled() ? sizeof(Nextsim::TimedIceOceanHeatFlux) : 0;
+}
+static Nextsim::BasicIceOceanHeatFlux i_BasicIceOceanHeatFlux;
+std::unique_ptr<Nextsim::IIceOceanHeatFlux> newBasicIceOceanHeatFlux()
+{
+    return std::unique_ptr<Nextsim::BasicIceOceanHeatFlux>(new Nextsim::BasicIceOceanHeatFlux);
+}
+
+static Nextsim::IConcentrationModel* p_IConcentrationModel;
+static size_t s_IConcentrationModel;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IConcentrationModel>() const
+{
+    return s_IConcentrationModel;
+}
+static Nextsim::TimedConcentrationModel d_IConcentrationModel;
+template<>
+Nextsim::IConcentrationModel& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedConcentrationModel::enabled()) {
+        d_IConcentrationModel.wrap(*p_IConcentrationModel);
+        return d_IConcentrationModel;
+    }
+    return *p_IConcentrationModel;
+}
+std::unique_ptr<Nextsim::IConcentrationModel> (*pf_IConcentrationModel)();
+template<>
+std::unique_ptr<Nextsim::IConcentrationModel> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedConcentrationModel::enabled()) {
+        return std::unique_ptr<Nextsim::IConcentrationModel>(new Nextsim::TimedConcentrationModel((*pf_IConcentrationModel)()));
+    }
+    return (*pf_IConcentrationModel)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IConcentrationModel>() const
+{
+    return Nextsim::TimedConcentrationModel::enabled() ? sizeof(Nextsim::TimedConcentrationModel) : 0;
+}
+static Nextsim::HiblerConcentration i_HiblerConcentration;
+std::unique_ptr<Nextsim::IConcentrationModel> newHiblerConcentration()
+{
+    return std::unique_ptr<Nextsim::HiblerConcentration>(new Nextsim::HiblerConcentration);
+}
+
+static Nextsim::IThermodynamics* p_IThermodynamics;
+static size_t s_IThermodynamics;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IThermodynamics>() const
+{
+    return s_IThermodynamics;
+}
+static Nextsim::TimedThermodynamics d_IThermodynamics;
+template<>
+Nextsim::IThermodynamics& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedThermodynamics::enabled()) {
+        d_IThermodynamics.wrap(*p_IThermodynamics);
+        return d_IThermodynamics;
+    }
+    return *p_IThermodynamics;
+}
+std::unique_ptr<Nextsim::IThermodynamics> (*pf_IThermodynamics)();
+template<>
+std::unique_ptr<Nextsim::IThermodynamics> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedThermodynamics::enabled()) {
+        return std::unique_ptr<Nextsim::IThermodynamics>(new Nextsim::TimedThermodynamics((*pf_IThermodynamics)()));
+    }
+    return (*pf_IThermodynamics)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IThermodynamics>() const
+{
+    return Nextsim::TimedThermodynamics::enabled() ? sizeof(Nextsim::TimedThermodynamics) : 0;
+}
+static Nextsim::ThermoIce0 i_ThermoIce0;
+std::unique_ptr<Nextsim::IThermodynamics> newThermoIce0()
+{
+    return std::unique_ptr<Nextsim::ThermoIce0>(new Nextsim::ThermoIce0);
+}
+
+static Nextsim::IPhysics1d* p_IPhysics1d;
+static size_t s_IPhysics1d;
+template<>
+size_t ModuleLoader::getInstanceSize<Nextsim::IPhysics1d>() const
+{
+    return s_IPhysics1d;
+}
+static Nextsim::TimedPhysics1d d_IPhysics1d;
+template<>
+Nextsim::IPhysics1d& ModuleLoader::getImplementation()
+{
+    if (Nextsim::TimedPhysics1d::enabled()) {
+        d_IPhysics1d.wrap(*p_IPhysics1d);
+        return d_IPhysics1d;
+    }
+    return *p_IPhysics1d;
+}
+std::unique_ptr<Nextsim::IPhysics1d> (*pf_IPhysics1d)();
+template<>
+std::unique_ptr<Nextsim::IPhysics1d> ModuleLoader::getInstance() const
+{
+    if (Nextsim::TimedPhysics1d::enabled()) {
+        return std::unique_ptr<Nextsim::IPhysics1d>(new Nextsim::TimedPhysics1d((*pf_IPhysics1d)()));
+    }
+    return (*pf_IPhysics1d)();
+}
+template<>
+size_t ModuleLoader::getDecoratorSize<Nextsim::IPhysics1d>() const
+{
+    return Nextsim::TimedPhysics1d::enabled() ? sizeof(Nextsim::TimedPhysics1d) : 0;
+}
+static Nextsim::NextsimPhysics i_NextsimPhysics;
+std::unique_ptr<Nextsim::IPhysics1d> newNextsimPhysics()
+{
+    return std::unique_ptr<Nextsim::NextsimPhysics>(new Nextsim::NextsimPhysics);
+}
+
@@ -0,0 +1,30 @@
+#include "include/IFreezingPoint.hpp"
+#include "include/LinearFreezing.hpp"
+#include "include/UnescoFreezing.hpp"
+#include "include/TimedFreezingPoint.hpp"
+
+#include "include/IStructure.hpp"
+#include "include/DevGrid.hpp"
+
+#include "include/IIceAlbedo.hpp"
+#include "include/SMUIceAlbedo.hpp"
+#include "include/SMU2IceAlbedo.hpp"
+#include "include/CCSMIceAlbedo.hpp"
+#include "include/TimedIceAlbedo.hpp"
+
+#include "include/IIceOceanHeatFlux.hpp"
+#include "include/BasicIceOceanHeatFlux.hpp"
+#include "include/TimedIceOceanHeatFlux.hpp"
+
+#include "include/IConcentrationModel.hpp"
+#include "include/HiblerConcentration.hpp"
+#include "include/TimedConcentrationModel.hpp"
+
+#include "include/IThermodynamics.hpp"
+#include "include/ThermoIce0.hpp"
+#include "include/TimedThermodynamics.hpp"
+
+#include "include/IPhysics1d.hpp"
+#include "include/NextsimPhysics.hpp"
+#include "include/TimedPhysics1d.hpp"
+
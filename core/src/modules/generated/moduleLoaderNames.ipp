@@ -0,0 +1,34 @@
+    m_availableImplementationNames = {
+        {
+        "Nextsim::IFreezingPoint", {
+            "Nextsim::LinearFreezing",
+            "Nextsim::UnescoFreezing",
+            }
+        },{
+        "Nextsim::IStructure", {
+            "Nextsim::DevGrid",
+            }
+        },{
+        "Nextsim::IIceAlbedo", {
+            "Nextsim::SMUIceAlbedo",
+            "Nextsim::SMU2IceAlbedo",
+            "Nextsim::CCSMIceAlbedo",
+            }
+        },{
+        "Nextsim::IIceOceanHeatFlux", {
+            "Nextsim::BasicIceOceanHeatFlux",
+            }
+        },{
+        "Nextsim::IConcentrationModel", {
+            "Nextsim::HiblerConcentration",
+            }
+        },{
+        "Nextsim::IThermodynamics", {
+            "Nextsim::ThermoIce0",
+            }
+        },{
+        "Nextsim::IPhysics1d", {
+            "Nextsim::NextsimPhysics",
+            }
+        },
+    };
@@ -20,11 +20,19 @@ namespace Nextsim {
 
 class DevGridIO;
 
-//! A class to hold a grid of ElementData instances in a fixed sized square grid.
+/*!
+ * @brief A class to hold a grid of ElementData instances in a rectangular grid.
+ *
+ * @details The size of the grid is read from the restart file, or is
+ * defaultNx by defaultNx elements if there is none, unless it has been set by
+ * resize().
+ */
 class DevGrid : public IStructure {
 public:
     DevGrid()
-        : pio(nullptr)
+        : m_nx(defaultNx)
+        , m_ny(defaultNx)
+        , pio(nullptr)
     {
     }
 
@@ -36,7 +44,8 @@ public:
         }
     }
 
-    const static int nx;
+    //! The default number of elements along each side of the grid
+    const static int defaultNx;
     const static std::string structureName;
 
     // Read/write override functions
@@ -44,10 +53,32 @@ public:
 
     void dump(const std::string& filePath) const override;
 
+    /*!
+     * @brief Sets the size of the grid from a restart file without reading
+     * or allocating any data.
+     *
+     * @param filePath The location of the restart file.
+     * @return The number of ice layers of the data in the file.
+     */
+    int initSize(const std::string& filePath);
+
     std::string structureType() const override { return structureName; };
 
     int nIceLayers() const override { return 1; };
 
+    //! The number of elements in the x direction
+    int nx() const { return m_nx; }
+    //! The number of elements in the y direction
+    int ny() const { return m_ny; }
+    /*!
+     * @brief Sets the size of the grid, keeping the data of as many elements
+     * as still fit.
+     *
+     * @param nx The number of elements in the x direction.
+     * @param ny The number of elements in the y direction.
+     */
+    void resize(int nx, int ny);
+
     // Cursor manipulation override functions
     int resetCursor() override;
     bool validCursor() const override;
@@ -55,6 +86,8 @@ public:
     const ElementData& cursorData() const override;
     void incrCursor() override;
 
+    bool contiguousData(ElementData*& first, ElementData*& last) override;
+
     //! Sets the pointer to the class that will perform the IO. Should be an instance of DevGridIO
     void setIO(IDevGridIO* p) { pio = p; }
 
@@ -63,6 +96,8 @@ private:
     const static std::string yDimName;
     const static std::string nIceLayersName;
 
+    int m_nx;
+    int m_ny;
     std::vector<ElementData> data;
 
     std::vector<ElementData>::iterator iCursor;
@@ -93,6 +93,19 @@ public:
      */
     virtual void incrCursor() = 0;
 
+    /*!
+     * @brief Gets the range of the element data, if it is stored as one
+     * contiguous array.
+     *
+     * @param first Set to the first element.
+     * @param last Set to one past the last element.
+     * @return false if the elements are only reachable through the cursor.
+     */
+    virtual bool contiguousData(ElementData*& /*first*/, ElementData*& /*last*/)
+    {
+        return false;
+    }
+
     class Cursor {
     public:
         Cursor(IStructure& ownerer)
@@ -0,0 +1,31 @@
+/*!
+ * @file TimedFreezingPoint.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDFREEZINGPOINT_HPP
+#define SRC_INCLUDE_TIMEDFREEZINGPOINT_HPP
+
+#include "IFreezingPoint.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the seawater freezing point calculation.
+class TimedFreezingPoint : public TimedModule<IFreezingPoint> {
+public:
+    using TimedModule<IFreezingPoint>::TimedModule;
+
+    double operator()(double sss) const override
+    {
+        static const Timer::Id timerId = Timer::id("IFreezingPoint");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        return (*p_impl)(sss);
+    }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDFREEZINGPOINT_HPP */
@@ -23,6 +23,16 @@ def get_fname(impl):
     """Returns the function name for the implementation, given its namespaced string name."""
     return f"new{denamespace(impl)}"
 
+def get_sname(full_name):
+    """Returns the name of the size of the stored implementation, given the
+    namespaced class name of the interface."""
+    return f"s_{denamespace(full_name)}"
+
+def get_dname(full_name):
+    """Returns the name of the stored decorator of the interface, given its
+    namespaced class name."""
+    return f"d_{denamespace(full_name)}"
+
 def headers(all_implementations, ipp_prefix, hpp_prefix):
     """Generates the moduleLoaderHeaders.ipp file."""
     with open(f"{ipp_prefix}moduleLoaderHeaders.ipp", "w", encoding="utf-8") as fil:
@@ -32,6 +42,9 @@ def headers(all_implementations, ipp_prefix, hpp_prefix):
             for impl in interface["implementations"]:
                 header_name = denamespace(impl)
                 fil.write(f"#include \"{hpp_prefix}{header_name}.hpp\"\n")
+            if "decorator" in interface:
+                header_name = denamespace(interface["decorator"])
+                fil.write(f"#include \"{hpp_prefix}{header_name}.hpp\"\n")
             # An extra line between interfaces
             fil.write("\n")
 
@@ -43,25 +56,78 @@ def functions(all_implementations, ipp_prefix):
             # Define the pointer to the stored implementation
             p_name = get_pname(name)
             fil.write(f"static {name}* {p_name};\n")
-            # Define the function that returns the pointer to the stored implementation
-            fil.write(
-                "template<>\n"
-                f"{name}& ModuleLoader::getImplementation()\n"
-                "{\n"
-                f"    return *{p_name};\n"
-                "}\n"
-                )
-            # Define the pointer to function
             pf_name = get_pfname(name)
-            fil.write(f"std::unique_ptr<{name}> (*{pf_name})();\n")
-            # Define function that call the function pointer
+            # The size of the stored implementation
+            s_name = get_sname(name)
+            fil.write(f"static size_t {s_name};\n")
             fil.write(
                 "template<>\n"
-                f"std::unique_ptr<{name}> ModuleLoader::getInstance() const\n"
+                f"size_t ModuleLoader::getInstanceSize<{name}>() const\n"
                 "{\n"
-                f"    return (*{pf_name})();\n"
+                f"    return {s_name};\n"
                 "}\n"
                 )
+            if "decorator" in interface:
+                decorator = interface["decorator"]
+                d_name = get_dname(name)
+                # The stored decorator, which wraps the stored implementation
+                fil.write(f"static {decorator} {d_name};\n")
+                # Return the decorated implementations when the decorator is enabled
+                fil.write(
+                    "template<>\n"
+                    f"{name}& ModuleLoader::getImplementation()\n"
+                    "{\n"
+                    f"    if ({decorator}::enabled()) ""{\n"
+                    f"        {d_name}.wrap(*{p_name});\n"
+                    f"        return {d_name};\n"
+                    "    }\n"
+                    f"    return *{p_name};\n"
+                    "}\n"
+                    )
+                fil.write(f"std::unique_ptr<{name}> (*{pf_name})();\n")
+                fil.write(
+                    "template<>\n"
+                    f"std::unique_ptr<{name}> ModuleLoader::getInstance() const\n"
+                    "{\n"
+                    f"    if ({decorator}::enabled()) ""{\n"
+                    f"        return std::unique_ptr<{name}>(new {decorator}((*{pf_name})()));\n"
+                    "    }\n"
+                    f"    return (*{pf_name})();\n"
+                    "}\n"
+                    )
+                fil.write(
+                    "template<>\n"
+                    f"size_t ModuleLoader::getDecoratorSize<{name}>() const\n"
+                    "{\n"
+                    f"    return {decorator}::enabled() ? sizeof({decorator}) : 0;\n"
+                    "}\n"
+                    )
+            else:
+                # Define the function that returns the pointer to the stored implementation
+                fil.write(
+                    "template<>\n"
+                    f"{name}& ModuleLoader::getImplementation()\n"
+                    "{\n"
+                    f"    return *{p_name};\n"
+                    "}\n"
+                    )
+                # Define the pointer to function
+                fil.write(f"std::unique_ptr<{name}> (*{pf_name})();\n")
+                # Define function that call the function pointer
+                fil.write(
+                    "template<>\n"
+                    f"std::unique_ptr<{name}> ModuleLoader::getInstance() const\n"
+                    "{\n"
+                    f"    return (*{pf_name})();\n"
+                    "}\n"
+                    )
+                fil.write(
+                    "template<>\n"
+                    f"size_t ModuleLoader::getDecoratorSize<{name}>() const\n"
+                    "{\n"
+                    "    return 0;\n"
+                    "}\n"
+                    )
             for impl in interface["implementations"]:
                 # The stored instance of the implementation
                 fil.write(f"static {impl} {get_iname(impl)};\n")
@@ -108,11 +174,13 @@ def assignments(all_implementations, ipp_prefix):
                 )
             p_name = get_pname(name)
             pf_name = get_pfname(name)
+            s_name = get_sname(name)
             for impl in interface["implementations"]:
                 fil.write(
                     f"if (impl == \"{impl}\") ""{\n"
                     f"                {p_name} = &{get_iname(impl)};\n"
                     f"                {pf_name} = &{get_fname(impl)};\n"
+                    f"                {s_name} = sizeof({impl});\n"
                     "            } else "
                     )
             fil.write(
@@ -0,0 +1,134 @@
+/*!
+ * @file restart_diff.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * Compares every field of the data group of a restart file with that of a
+ * reference restart file, within absolute and relative tolerances given for
+ * all fields or read per field from a file (see
+ * FieldComparison::readTolerances()). The result and ULP histogram of each
+ * field are written to standard output. Exits with 0 if all fields pass, 1 if
+ * any fails or is missing from either file, and 2 on any other error.
+ *
+ * Usage: restart_diff reference.nc test.nc [--abs 0] [--rel 0]
+ *                     [--tolerances file] [--threads 0]
+ */
+
+#include "include/FieldComparison.hpp"
+#include "include/IStructure.hpp"
+
+#include <ncDim.h>
+#include <ncFile.h>
+#include <ncGroup.h>
+#include <ncVar.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Field {
+    std::vector<size_t> shape;
+    std::vector<double> values;
+};
+
+// Reads all the variables of the data group of a restart file
+std::map<std::string, Field> readFields(const std::string& fileName)
+{
+    netCDF::NcFile ncFile(fileName, netCDF::NcFile::read);
+    netCDF::NcGroup dataGroup = ncFile.getGroup(Nextsim::IStructure::dataNodeName());
+    if (dataGroup.isNull())
+        throw std::invalid_argument(fileName + " has no data group");
+
+    std::map<std::string, Field> fields;
+    for (auto namedVar : dataGroup.getVars()) {
+        Field& field = fields[namedVar.first];
+        size_t size = 1;
+        for (int d = 0; d < namedVar.second.getDimCount(); ++d) {
+            field.shape.push_back(namedVar.second.getDim(d).getSize());
+            size *= field.shape.back();
+        }
+        field.values.resize(size);
+        namedVar.second.getVar(field.values.data());
+    }
+    ncFile.close();
+    return fields;
+}
+
+} /* anonymous namespace */
+
+int main(int argc, char* argv[])
+{
+    const std::string usage = " reference.nc test.nc [--abs 0] [--rel 0] [--tolerances file]"
+                              " [--threads 0]";
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << usage << std::endl;
+        return 2;
+    }
+
+    try {
+        Nextsim::FieldComparison::Tolerance tolerance = { 0, 0 };
+        std::string tolerancesFile;
+        int nThreads = 0;
+        for (int i = 3; i < argc; i += 2) {
+            const std::string option = argv[i];
+            if (i + 1 == argc)
+                throw std::invalid_argument("No value given for " + option);
+            if (option == "--abs") {
+                tolerance.absolute = std::stod(argv[i + 1]);
+            } else if (option == "--rel") {
+                tolerance.relative = std::stod(argv[i + 1]);
+            } else if (option == "--tolerances") {
+                tolerancesFile = argv[i + 1];
+            } else if (option == "--threads") {
+                nThreads = std::stoi(argv[i + 1]);
+            } else {
+                throw std::invalid_argument("Unknown option " + option);
+            }
+        }
+
+        Nextsim::FieldComparison comparison(nThreads);
+        comparison.setDefaultTolerance(tolerance);
+        if (!tolerancesFile.empty()) {
+            std::ifstream tolerances(tolerancesFile);
+            if (!tolerances)
+                throw std::invalid_argument("Could not open " + tolerancesFile);
+            comparison.readTolerances(tolerances);
+        }
+
+        std::map<std::string, Field> reference = readFields(argv[1]);
+        std::map<std::string, Field> test = readFields(argv[2]);
+
+        bool passed = true;
+        std::vector<Nextsim::FieldComparison::Result> results;
+        for (const auto& namedField : reference) {
+            auto iter = test.find(namedField.first);
+            if (iter == test.end()) {
+                std::cout << namedField.first << " is missing from " << argv[2] << std::endl;
+                passed = false;
+            } else if (iter->second.shape != namedField.second.shape) {
+                std::cout << namedField.first << " differs in shape" << std::endl;
+                passed = false;
+            } else {
+                results.push_back(comparison.compare(
+                    namedField.first, namedField.second.values, iter->second.values));
+                passed = passed && results.back().passed();
+            }
+        }
+        for (const auto& namedField : test) {
+            if (reference.count(namedField.first) == 0) {
+                std::cout << namedField.first << " is missing from " << argv[1] << std::endl;
+                passed = false;
+            }
+        }
+        comparison.writeReport(results, std::cout);
+        return passed ? 0 : 1;
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl << "Usage: " << argv[0] << usage << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,130 @@
+/*!
+ * @file CapacityPlan_test.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/CapacityPlan.hpp"
+#include "include/Configurator.hpp"
+#include "include/ElementData.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/ModuleTiming.hpp"
+#include "include/NextsimPhysics.hpp"
+#include "include/TimedPhysics1d.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace Nextsim {
+
+TEST_CASE("Memory and I/O volume of a planned run", "[CapacityPlan]")
+{
+    Configurator::clear();
+    std::stringstream config;
+    config << "[capacity]" << std::endl
+           << "processes = 4" << std::endl
+           << "output_interval = 6" << std::endl
+           << "checkpoint_interval = 24" << std::endl;
+    Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(config.str())));
+
+    ModuleLoader& loader = ModuleLoader::getLoader();
+    loader.init();
+    loader.setImplementation("Nextsim::IPhysics1d", "Nextsim::NextsimPhysics");
+
+    CapacityPlan plan;
+    plan.configure();
+    plan.setGrid("devgrid", 100, 50, 3);
+    // Two days of hourly steps
+    plan.setRun(48, 3600);
+
+    REQUIRE(plan.columnsPerProcess() == 1250);
+    // Eight fields of 5000 elements
+    const double restartBytes = 5000 * 8 * sizeof(double);
+    REQUIRE(plan.restartBytes() == restartBytes);
+    // Four outputs and one checkpoint per day
+    REQUIRE(plan.ioBytesPerDay() == 5 * restartBytes);
+    REQUIRE(plan.bytesRead() == restartBytes);
+    // Eight outputs, two checkpoints and the final restart
+    REQUIRE(plan.bytesWritten() == 11 * restartBytes);
+    // The elements, their three heap allocations and the restart buffers of a
+    // quarter of the grid, allowing up to 32 bytes of allocator overhead for
+    // each allocation
+    const double elementBytes
+        = sizeof(ElementData) + 2 * 3 * sizeof(double) + sizeof(NextsimPhysics);
+    const double restartBufferBytes = 8 * sizeof(double);
+    const double minimumBytes = 1250 * (elementBytes + restartBufferBytes);
+    REQUIRE(plan.memoryPerProcess() >= minimumBytes);
+    REQUIRE(plan.memoryPerProcess() <= minimumBytes + 1250 * 3 * 32);
+    // Timing the modules wraps each physics implementation in a decorator
+    ModuleTiming::setInterval(2);
+    const double timedBytes = plan.memoryPerProcess();
+    ModuleTiming::setInterval(0);
+    REQUIRE(timedBytes - plan.memoryPerProcess() >= 1250 * sizeof(TimedPhysics1d));
+    REQUIRE(timedBytes - plan.memoryPerProcess() <= 1250 * (sizeof(TimedPhysics1d) + 32));
+
+    // Uncalibrated
+    REQUIRE(plan.computeSeconds() == 0);
+    REQUIRE(plan.ioSeconds() == 0);
+    std::stringstream report;
+    plan.report(report);
+    REQUIRE(report.str().find("not calibrated") != std::string::npos);
+
+    std::stringstream badConfig;
+    badConfig << "[capacity]" << std::endl << "threads = 0" << std::endl;
+    Configurator::clear();
+    Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(badConfig.str())));
+    REQUIRE_THROWS_AS(plan.configure(), std::domain_error);
+
+    Configurator::clear();
+}
+
+TEST_CASE("Run time from calibrated costs", "[CapacityPlan]")
+{
+    Configurator::clear();
+    ModuleLoader& loader = ModuleLoader::getLoader();
+    loader.init();
+    loader.setImplementation("Nextsim::IPhysics1d", "Nextsim::NextsimPhysics");
+
+    CapacityPlan plan;
+    plan.configure();
+    // Restart files of 48 MB
+    plan.setGrid("devgrid", 1024, 1024, 1);
+    plan.setRun(10, 3600);
+
+    // The output of nextsim_column_proxy
+    std::stringstream columnCosts;
+    columnCosts << "pass,columns,threads,steps,seconds,ns_per_column,columns_per_s" << std::endl
+                << "\"integration\",1000,1,10,0.002,200,5e+06" << std::endl
+                << "\"total\",1000,1,10,0.01,1000,1e+06" << std::endl;
+    plan.readColumnCosts(columnCosts);
+    // 10 steps of 1024 x 1024 columns at a microsecond each
+    REQUIRE(plan.computeSeconds() == Approx(10.48576));
+
+    // The output of nextsim_io_bench, of which the largest files are used
+    std::stringstream ioRates;
+    ioRates << "operation,nx,ny,layers,deflate,chunk,file_MB,part,seconds,MB,MB_per_s,fraction"
+            << std::endl
+            << "dump,64,64,1,0,0,0.2,\"total\",0.01,0.2,20,1" << std::endl
+            << "dump,1024,1024,1,0,0,48,\"total\",0.5,48,96,1" << std::endl
+            << "dump,1024,1024,1,0,0,48,\"write tice\",0.1,8,80,0.2" << std::endl
+            << "generateFromFile,1024,1024,1,0,0,48,\"total\",0.001,0,0,1" << std::endl
+            << "init,1024,1024,1,0,0,48,\"total\",0.25,48,192,1" << std::endl;
+    plan.readIORates(ioRates);
+    // 48 MB read at 192 MB/s and written at 96 MB/s
+    REQUIRE(plan.ioSeconds() == Approx(0.25 + 0.5));
+
+    std::stringstream report;
+    plan.report(report);
+    REQUIRE(report.str().find("Estimated run time: 11.236 s") != std::string::npos);
+
+    std::stringstream notCosts("pass,columns\n\"total\",1000\n");
+    REQUIRE_THROWS_AS(plan.readColumnCosts(notCosts), std::invalid_argument);
+    std::stringstream notRates("operation,part\ndump,total\n");
+    REQUIRE_THROWS_AS(CapacityPlan().readIORates(notRates), std::invalid_argument);
+}
+
+} /* namespace Nextsim */
@@ -39,4 +39,15 @@ TEST_CASE("Parse config file names", "[CommandLineParser]")
     REQUIRE(cfgs[cfgs.size() - 1] == finalFileName);
 }
 
+TEST_CASE("Parse the dry run switch", "[CommandLineParser]")
+{
+    ArgV argv1({ "nextsimdg", "--config-file", "config.cfg" });
+    REQUIRE(!CommandLineParser(argv1.argc(), argv1()).isDryRun());
+
+    ArgV argv2({ "nextsimdg", "--dry-run", "--config-file", "config.cfg" });
+    CommandLineParser clp2(argv2.argc(), argv2());
+    REQUIRE(clp2.isDryRun());
+    REQUIRE(clp2.getConfigFileNames().size() == 1);
+}
+
 } /* namespace Nextsim */
@@ -13,6 +13,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -229,4 +230,144 @@ TEST_CASE("Parse config streams for two overlapping class, try", "[Configurator]
     REQUIRE(confih.getWeight() == targetWeight);
 }
 
+TEST_CASE("The command line overrides the config streams", "[Configurator]")
+{
+    Configurator::clear();
+    Config3::clearConfigurationMap();
+
+    std::stringstream text;
+    text << "[config]" << std::endl << "value = 12" << std::endl;
+    text << "[data]" << std::endl << "weight = 0.25" << std::endl;
+    Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(text.str())));
+
+    // Both forms of long option, and an option not configured by any class
+    ArgV argv({ "nextsimdg", "--config.value", "99", "--data.weight=0.5", "--verbose" });
+    Configurator::setCommandLine(argv.argc(), argv());
+
+    Config3 config;
+    tryConfigure(config);
+    REQUIRE(config.getValue() == 99);
+    REQUIRE(config.getWeight() == 0.5);
+    REQUIRE(Configurator::get("verbose", false));
+
+    // Later streams do not override earlier ones
+    std::stringstream later;
+    later << "[data]" << std::endl << "weight = 0.75" << std::endl;
+    later << "[other]" << std::endl << "name = later" << std::endl;
+    Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(later.str())));
+    Configurator::setCommandLine(0, nullptr);
+    tryConfigure(config);
+    REQUIRE(config.getValue() == 12);
+    REQUIRE(config.getWeight() == 0.25);
+    REQUIRE(Configurator::get<std::string>("other.name", "") == "later");
+
+    // Typed lookups of the same value
+    REQUIRE(Configurator::get("config.value", 0) == 12);
+    REQUIRE(Configurator::get("config.value", 0.) == 12.);
+    REQUIRE(Configurator::get<std::string>("config.value", "") == "12");
+    REQUIRE(Configurator::get("config.absent", -3) == -3);
+    // A config value that cannot be converted is ignored
+    REQUIRE(Configurator::get("other.name", 7) == 7);
+    REQUIRE(Configurator::get("other.name", 8) == 8);
+
+    Configurator::clear();
+}
+
+TEST_CASE("Command line values", "[Configurator]")
+{
+    Configurator::clear();
+
+    ArgV argv({ "nextsimdg", "--config.value", "-5", "--data.weight", "-.25", "--switch",
+        "--files", "a.cfg", "--files=b.cfg", "--name", "text", "--config.value=6" });
+    Configurator::setCommandLine(argv.argc(), argv());
+
+    // Negative numbers are values, not options
+    REQUIRE(Configurator::get("data.weight", 0.) == -0.25);
+    REQUIRE(Configurator::get("switch", false));
+    // The values of a repeated option are collected in order
+    REQUIRE(Configurator::get("files", std::vector<std::string>())
+        == std::vector<std::string>({ "a.cfg", "b.cfg" }));
+    REQUIRE(Configurator::get("config.value", std::vector<int>()) == std::vector<int>({ -5, 6 }));
+    REQUIRE_THROWS(Configurator::get("config.value", 0));
+    // A command line value that cannot be converted throws
+    REQUIRE_THROWS(Configurator::get("name", 0));
+    REQUIRE(Configurator::get<std::string>("name", "") == "text");
+
+    Configurator::clear();
+}
+
+TEST_CASE("Switches do not take the argument after them", "[Configurator]")
+{
+    Configurator::clear();
+
+    ArgV argv({ "nextsimdg", "--verbose", "input.nc", "--dry-run", "input2.nc", "--level", "3",
+        "--quiet", "no" });
+    Configurator::setCommandLine(argv.argc(), argv());
+
+    // A switch followed by a positional argument
+    REQUIRE(Configurator::get("verbose", false));
+    // An option with a value
+    REQUIRE(Configurator::get("level", 0) == 3);
+    // A switch followed by a boolean value takes it
+    REQUIRE(!Configurator::get("quiet", true));
+
+    boost::program_options::options_description opt;
+    opt.add_options()("dry-run", boost::program_options::bool_switch(), "")(
+        "level", boost::program_options::value<int>()->default_value(0), "");
+    boost::program_options::variables_map vm = Configurator::parse(opt);
+    REQUIRE(vm["dry-run"].as<bool>());
+    REQUIRE(vm["level"].as<int>() == 3);
+
+    Configurator::clear();
+}
+
+// Creates a config stream of the given number of sections of ten options
+static std::unique_ptr<std::istream> longConfig(int nSections)
+{
+    std::unique_ptr<std::stringstream> text(new std::stringstream);
+    *text << "[config]" << std::endl << "value = 42" << std::endl;
+    for (int s = 0; s < nSections; ++s) {
+        *text << "[section" << s << "]" << std::endl;
+        for (int o = 0; o < 10; ++o) {
+            *text << "option" << o << " = " << s * o << std::endl;
+        }
+    }
+    return std::unique_ptr<std::istream>(text.release());
+}
+
+// Configures many options, several times over
+static void configureOptions()
+{
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        int sum = 0;
+        for (int option = 0; option < 100; ++option) {
+            sum += Configured<Config3>::getConfiguration("config.value", -1);
+            sum += Configured<Config3>::getConfiguration(
+                "section0.option" + std::to_string(option % 10), 0);
+        }
+        REQUIRE(sum == 100 * 42 + 0);
+    }
+}
+
+TEST_CASE("Configuration parses each source once", "[Configurator]")
+{
+    Configurator::clear();
+    Config3::clearConfigurationMap();
+
+    const int parsesBefore = Configurator::parseCount();
+    Configurator::addStream(longConfig(10));
+    REQUIRE(Configurator::parseCount() == parsesBefore + 1);
+    configureOptions();
+    // Configuring options does not parse the sources again
+    REQUIRE(Configurator::parseCount() == parsesBefore + 1);
+
+    Configurator::clearStreams();
+    Configurator::addStream(longConfig(10000));
+    REQUIRE(Configurator::parseCount() == parsesBefore + 2);
+    configureOptions();
+    REQUIRE(Configurator::parseCount() == parsesBefore + 2);
+
+    Configurator::clear();
+}
+
 } /* namespace Nextsim */
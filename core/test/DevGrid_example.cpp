@@ -29,8 +29,8 @@ TEST_CASE("Write out a DevGrid restart file", "[DevGrid]")
     grid.setIO(new DevGridIO(grid));
     // Fill in the data. It is not real data.
     grid.resetCursor();
-    int nx = DevGrid::nx;
-    int ny = DevGrid::nx;
+    int nx = grid.nx();
+    int ny = grid.ny();
     double yFactor = 0.01;
     double xFactor = 0.0001;
 
@@ -55,7 +55,7 @@ TEST_CASE("Read the example file, if it exists", "[DevGrid]")
     DevGrid grid;
     grid.init("");
     grid.resetCursor();
-    int targetIndex = 7 * DevGrid::nx + 3;
+    int targetIndex = 7 * grid.nx() + 3;
     for (int i = 0; i < targetIndex; ++i) {
         grid.incrCursor();
     }
@@ -30,8 +30,8 @@ TEST_CASE("Write out a DevGrid restart file", "[DevGrid]")
     grid.setIO(new DevGridIO(grid));
     // Fill in the data. It is not real data.
     grid.resetCursor();
-    int nx = DevGrid::nx;
-    int ny = DevGrid::nx;
+    int nx = grid.nx();
+    int ny = grid.ny();
     double yFactor = 0.01;
     double xFactor = 0.0001;
 
@@ -69,7 +69,7 @@ TEST_CASE("Write out a DevGrid restart file", "[DevGrid]")
     }
 
     grid2.cursor = 0;
-    int targetIndex = 7 * DevGrid::nx + 3;
+    int targetIndex = 7 * grid2.nx() + 3;
     for (int i = 0; i < targetIndex; ++i) {
         ++grid2.cursor;
     }
@@ -101,4 +101,75 @@ TEST_CASE("Write out a DevGrid restart file", "[DevGrid]")
 
     std::remove(filename.c_str());
 }
+
+TEST_CASE("DevGrid restarts of any size", "[DevGrid]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    const int nx = 13;
+    const int ny = 7;
+    DevGrid grid;
+    grid.resize(nx, ny);
+    grid.init("");
+    grid.setIO(new DevGridIO(grid));
+    int index = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor = PrognosticGenerator().hice(0.01 * index++).cice(1).tice({ -1 });
+    }
+    REQUIRE(index == nx * ny);
+    grid.dump(filename);
+
+    // The grid takes the size of the file
+    DevGrid grid2;
+    grid2.setIO(new DevGridIO(grid2));
+    grid2.init(filename);
+    REQUIRE(grid2.nx() == nx);
+    REQUIRE(grid2.ny() == ny);
+    index = 0;
+    for (grid2.cursor = 0; grid2.cursor; ++grid2.cursor) {
+        REQUIRE(grid2.cursor->iceThickness() == 0.01 * index++);
+    }
+    REQUIRE(index == nx * ny);
+
+    REQUIRE_THROWS_AS(grid2.resize(0, 1), std::invalid_argument);
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Compressed and chunked DevGrid restarts", "[DevGrid]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    const int nx = 13;
+    const int ny = 7;
+    DevGrid grid;
+    grid.resize(nx, ny);
+    grid.init("");
+    DevGridIO* io = new DevGridIO(grid);
+    // Chunks which do not divide the grid, and are larger than it in y
+    io->setCompression(4);
+    io->setChunking(5, 10);
+    grid.setIO(io);
+    int index = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor = PrognosticGenerator().hice(0.01 * index++).cice(1).tice({ -1, -1.5 });
+    }
+    grid.dump(filename);
+
+    DevGrid grid2;
+    grid2.setIO(new DevGridIO(grid2));
+    grid2.init(filename);
+    REQUIRE(grid2.nx() == nx);
+    REQUIRE(grid2.ny() == ny);
+    index = 0;
+    for (grid2.cursor = 0; grid2.cursor; ++grid2.cursor) {
+        REQUIRE(grid2.cursor->iceThickness() == 0.01 * index++);
+        REQUIRE(grid2.cursor->iceTemperature(1) == -1.5);
+    }
+
+    REQUIRE_THROWS_AS(io->setCompression(10), std::invalid_argument);
+    REQUIRE_THROWS_AS(io->setChunking(-1, 1), std::invalid_argument);
+
+    std::remove(filename.c_str());
+}
 }
@@ -1,12 +1,290 @@
 /*!
- * @file DevIterant_test.cpp
+ * @file DevStep_test.cpp
  *
  * @date Jan 12, 2022
  * @author Tim Spain <timothy.spain@nersc.no>
  */
 
-#include "../src/include/DevStep.hpp"
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/AllocationCounter.hpp"
+#include "include/DevGrid.hpp"
+#include "include/DevStep.hpp"
+#include "include/DummyExternalData.hpp"
+#include "include/Logged.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticGenerator.hpp"
+#include "include/ScopedTimer.hpp"
+#include "include/Timer.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace Nextsim {
 
+TEST_CASE("The steady state time step does not allocate", "[DevStep]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor
+            = PrognosticGenerator().hice(0.1).cice(0.5).hsnow(0.01).sst(-1.5).sss(32.).tice(
+                { -2. });
+    }
+    DummyExternalData::setAll(grid);
+
+    DevStep step;
+    step.setInitialData(grid);
+    // Nor does the health check of a healthy step
+    step.setHealthCheck(HealthCheck::defaultMaxColumns);
+    ScopedTimer::setTimerAddress(&Timer::main);
+    Timer::main.reset();
+    REQUIRE(Timer::enableAllocationCounting(true));
+
+    // The first step creates the timers
+    const Iterator::Duration dt = 600;
+    step.iterate(dt);
+
+    const AllocationCounter::Counts before = AllocationCounter::threadCounts();
+    const int nSteps = 5;
+    for (int i = 0; i < nSteps; ++i) {
+        step.iterate(dt);
+    }
+    const AllocationCounter::Counts after = AllocationCounter::threadCounts();
+    Timer::enableAllocationCounting(false);
+
+    std::cout << Timer::main << std::endl;
+    REQUIRE(after.allocations - before.allocations == 0);
+    REQUIRE(after.bytes - before.bytes == 0);
+}
+
+TEST_CASE("Health check of the prognostic fields", "[DevStep]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    PrognosticData data;
+    auto state = [](double hice, double cice, double hsnow, double tice) {
+        return PrognosticGenerator().hice(hice).cice(cice).hsnow(hsnow).sst(-1.5).sss(32.).tice(
+            { tice });
+    };
+    data = state(0.1, 0.5, 0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == 0);
+    data = state(0., 0., 0., -1.);
+    REQUIRE(HealthCheck::check(data) == 0);
+    data = state(nan, 0.5, 0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::NOT_FINITE);
+    data = state(0.1, 0.5, 0.01, -inf);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::NOT_FINITE);
+    data = state(0.1, 1.5, 0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::CONCENTRATION);
+    data = state(0.1, -0.1, 0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::CONCENTRATION);
+    data = state(-0.1, 0.5, 0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::NEGATIVE_THICKNESS);
+    data = state(0.1, 0.5, -0.01, -2.);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::NEGATIVE_THICKNESS);
+    data = state(0.1, 0.5, 0.01, 0.5);
+    REQUIRE(HealthCheck::check(data) == HealthCheck::TOO_WARM);
+    data = state(-0.1, 1.5, 0.01, 0.5);
+    REQUIRE(HealthCheck::check(data)
+        == (HealthCheck::CONCENTRATION | HealthCheck::NEGATIVE_THICKNESS | HealthCheck::TOO_WARM));
+
+    // Only the first columns are recorded
+    HealthCheck check(2);
+    for (long i = 0; i < 3; ++i) {
+        check.record(i, data, HealthCheck::check(data));
+    }
+    REQUIRE(check.nFailed() == 3);
+    REQUIRE(check.columns().size() == 2);
+    REQUIRE(check.columns()[1].index == 1);
+    REQUIRE(check.columns()[1].state.iceConcentration() == 1.5);
+    std::stringstream report;
+    check.report(report);
+    REQUIRE(report.str().find("3 columns failed") != std::string::npos);
+    REQUIRE(report.str().find("column 1: concentration outside [0, 1], negative thickness")
+        != std::string::npos);
+    check.reset();
+    REQUIRE(!check.failed());
+}
+
+TEST_CASE("A failing health check stops the model", "[DevStep]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor
+            = PrognosticGenerator().hice(0.1).cice(0.5).hsnow(0.01).sst(-1.5).sss(32.).tice(
+                { -2. });
+    }
+    DummyExternalData::setAll(grid);
+
+    DevStep step;
+    step.setInitialData(grid);
+    step.setHealthCheck(HealthCheck::defaultMaxColumns);
+    const Iterator::Duration dt = 600;
+    step.iterate(dt);
+    REQUIRE(!step.getHealthCheck().failed());
+
+    // Corrupt one column
+    const long badIndex = 7;
+    grid.cursor = 0;
+    for (long i = 0; i < badIndex; ++i) {
+        ++grid.cursor;
+    }
+    *grid.cursor = PrognosticGenerator()
+                       .hice(std::numeric_limits<double>::quiet_NaN())
+                       .cice(0.5)
+                       .hsnow(0.01)
+                       .sst(-1.5)
+                       .sss(32.)
+                       .tice({ -2. });
+    REQUIRE_THROWS_AS(step.iterate(dt), std::runtime_error);
+    const HealthCheck& check = step.getHealthCheck();
+    REQUIRE(check.nFailed() == 1);
+    REQUIRE(check.columns()[0].index == badIndex);
+    REQUIRE(check.columns()[0].failures & HealthCheck::NOT_FINITE);
+    REQUIRE(std::isnan(check.columns()[0].state.iceThickness()));
+
+    // Without the check, the corruption is carried on silently
+    step.setHealthCheck(0);
+    REQUIRE_NOTHROW(step.iterate(dt));
+}
+
+TEST_CASE("The derived data report is logged at debug level", "[DevStep]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor
+            = PrognosticGenerator().hice(0.1).cice(0.5).hsnow(0.01).sst(-1.5).sss(32.).tice(
+                { -2. });
+    }
+    DummyExternalData::setAll(grid);
+
+    DevStep step;
+    step.setInitialData(grid);
+    std::stringstream log;
+    Logged::setStream(log);
+    const Iterator::Duration dt = 600;
+
+    // Every derived field of every column is calculated in the first step
+    Logged::setMinimumLevel(Logged::DEBUG);
+    step.iterate(dt);
+    Logged::flush();
+    const std::string nColumns = std::to_string(DevGrid::defaultNx * DevGrid::defaultNx);
+    REQUIRE(log.str().find("step 1: derived data recalculated in " + nColumns + " columns")
+        != std::string::npos);
+    REQUIRE(log.str().find("specificHumidityAir = " + nColumns) != std::string::npos);
+
+    // Nothing is logged above debug level
+    log.str("");
+    Logged::setMinimumLevel(Logged::INFO);
+    step.iterate(dt);
+    Logged::flush();
+    Logged::setStream(std::cout);
+    REQUIRE(log.str().empty());
+}
+
+TEST_CASE("The work of the stages makes up the work of the columns", "[DevStep]")
+{
+    IPhysics1d::DerivedDataReport report;
+    REQUIRE(DevStep::columnFlops(report) == 0);
+    REQUIRE(DevStep::columnBytes(report, 0) == 0);
+
+    report.countColumn();
+    const long nLayers = 3;
+    double flops = 0;
+    double bytes = 0;
+    for (int stage = 0; stage < DevStep::N_STAGES; ++stage) {
+        const DevStep::Stage s = static_cast<DevStep::Stage>(stage);
+        INFO(DevStep::stageName(s));
+        REQUIRE(DevStep::stageFlops(s, report) > 0);
+        REQUIRE(DevStep::stageBytes(s, report, nLayers) > 0);
+        flops += DevStep::stageFlops(s, report);
+        bytes += DevStep::stageBytes(s, report, nLayers);
+    }
+    REQUIRE(DevStep::columnFlops(report) == flops);
+    REQUIRE(DevStep::columnBytes(report, nLayers) == bytes);
+
+    // The layers are only touched by the integration
+    for (int stage = 0; stage < DevStep::N_STAGES; ++stage) {
+        const DevStep::Stage s = static_cast<DevStep::Stage>(stage);
+        INFO(DevStep::stageName(s));
+        const double layerBytes
+            = DevStep::stageBytes(s, report, nLayers) - DevStep::stageBytes(s, report, 0);
+        if (s == DevStep::INTEGRATION)
+            REQUIRE(layerBytes == nLayers * 2 * sizeof(double));
+        else
+            REQUIRE(layerBytes == 0);
+    }
+
+    // Recalculated derived fields only add to the work of the derived data
+    IPhysics1d::DerivedDataReport recalculated = report;
+    recalculated.countRecalculation(IPhysics1d::SPECIFIC_HUMIDITY_AIR);
+    recalculated.countRecalculation(IPhysics1d::HEAT_CAPACITY_WET_AIR);
+    REQUIRE(DevStep::stageFlops(DevStep::DERIVED_DATA, recalculated)
+        > DevStep::stageFlops(DevStep::DERIVED_DATA, report));
+    REQUIRE(DevStep::stageBytes(DevStep::DERIVED_DATA, recalculated, 0)
+        > DevStep::stageBytes(DevStep::DERIVED_DATA, report, 0));
+    REQUIRE(DevStep::stageFlops(DevStep::FLUXES, recalculated)
+        == DevStep::stageFlops(DevStep::FLUXES, report));
+
+    // The work of each stage is proportional to the columns
+    IPhysics1d::DerivedDataReport twice = recalculated;
+    twice.countColumn();
+    twice.countRecalculation(IPhysics1d::SPECIFIC_HUMIDITY_AIR);
+    twice.countRecalculation(IPhysics1d::HEAT_CAPACITY_WET_AIR);
+    REQUIRE(DevStep::columnFlops(twice) == 2 * DevStep::columnFlops(recalculated));
+    REQUIRE(DevStep::columnBytes(twice, 2 * nLayers)
+        == 2 * DevStep::columnBytes(recalculated, nLayers));
+}
+
+TEST_CASE("The stages of the sampled columns are timed", "[DevStep]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor
+            = PrognosticGenerator().hice(0.1).cice(0.5).hsnow(0.01).sst(-1.5).sss(32.).tice(
+                { -2. });
+    }
+    DummyExternalData::setAll(grid);
+
+    DevStep step;
+    step.setInitialData(grid);
+    ScopedTimer::setTimerAddress(&Timer::main);
+    Timer::main.reset();
+    const int interval = DevStep::stageSampling();
+    DevStep::setStageSampling(1);
+    const Iterator::Duration dt = 600;
+    step.iterate(dt);
+    DevStep::setStageSampling(interval);
+
+    const long nColumns = Timer::main.items("column physics");
+    REQUIRE(nColumns == DevGrid::defaultNx * DevGrid::defaultNx);
+    const std::vector<Timer::Key> stages = Timer::main.children("column physics");
+    REQUIRE(stages.size() == DevStep::N_STAGES);
+    for (int stage = 0; stage < DevStep::N_STAGES; ++stage) {
+        const DevStep::Stage s = static_cast<DevStep::Stage>(stage);
+        REQUIRE(stages[stage] == DevStep::stageName(s));
+        REQUIRE(Timer::main.items(DevStep::stageName(s)) == nColumns);
+    }
+}
+
 } /* namespace Nextsim */
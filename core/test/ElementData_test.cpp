@@ -62,13 +62,13 @@ TEST_CASE("Physics test using NextsimPhysics", "[ElementData]")
     REQUIRE(data.iceTemperature(0) == tice[0]);
     REQUIRE(data.iceTemperature(2) == tice[2]);
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 330;
-    data.incomingShortwave() = 50;
-    data.snowfall() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(330);
+    data.setIncomingShortwave(50);
+    data.setSnowfall(0);
 
     data.windSpeed() = 5;
 
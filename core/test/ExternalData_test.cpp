@@ -4,8 +4,41 @@
  * @author Tim Spain <timothy.spain@nersc.no>
  */
 
-#include <ExternalData.hpp>
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/ExternalData.hpp"
 
 namespace Nextsim {
 
+TEST_CASE("Setting one field leaves the others unchanged", "[ExternalData]")
+{
+    ExternalData a;
+    a.setAirTemperature(-1).setIncomingLongwave(311);
+    REQUIRE(a.airTemperature() == -1);
+    REQUIRE(a.incomingLongwave() == 311);
+    REQUIRE(a.airPressure() == 0);
+
+    a.setAirTemperature(-2);
+    REQUIRE(a.airTemperature() == -2);
+    REQUIRE(a.incomingLongwave() == 311);
+
+    a.setMixedLayerDepth(10);
+    REQUIRE(a.mixedLayerBulkHeatCapacity() == Approx(10 * Water::rhoOcean * Water::cp));
+    a.setMixingRatio(-1);
+    REQUIRE(!a.hasMixingRatio());
+}
+
+TEST_CASE("Fields are copied", "[ExternalData]")
+{
+    ExternalData a;
+    a.setAirPressure(9.9e4);
+
+    ExternalData b = a;
+    REQUIRE(b.airPressure() == 9.9e4);
+    b.setAirPressure(9e4);
+    REQUIRE(a.airPressure() == 9.9e4);
+    REQUIRE(b.airPressure() == 9e4);
+}
+
 } /* namespace Nextsim */
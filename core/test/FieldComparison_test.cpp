@@ -0,0 +1,129 @@
+/*!
+ * @file FieldComparison_test.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/FieldComparison.hpp"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Distances in units in the last place", "[FieldComparison]")
+{
+    const double one = 1;
+    const double next = std::nextafter(one, 2.);
+    REQUIRE(FieldComparison::ulpDistance(one, one) == 0);
+    REQUIRE(FieldComparison::ulpDistance(one, next) == 1);
+    REQUIRE(FieldComparison::ulpDistance(next, one) == 1);
+    REQUIRE(FieldComparison::ulpDistance(0., -0.) == 0);
+    // Across zero
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    REQUIRE(FieldComparison::ulpDistance(-tiny, tiny) == 2);
+
+    REQUIRE(FieldComparison::ulpBin(0) == 0);
+    REQUIRE(FieldComparison::ulpBin(1) == 1);
+    REQUIRE(FieldComparison::ulpBin(3) == 2);
+    REQUIRE(FieldComparison::ulpBin(4) == 3);
+    REQUIRE(FieldComparison::ulpBinLabel(3) == "4-7");
+    REQUIRE(FieldComparison::ulpBinLabel(FieldComparison::ulpBins - 1) == "NaN");
+}
+
+TEST_CASE("Compare fields within tolerances", "[FieldComparison]")
+{
+    FieldComparison comparison(1);
+    std::vector<double> reference = { 1, 2, 4, -8, 0 };
+    std::vector<double> test = reference;
+
+    // Identical fields pass with zero tolerances
+    FieldComparison::Result result = comparison.compare("hice", reference, test);
+    REQUIRE(result.passed());
+    REQUIRE(result.maxAbsolute == 0);
+    REQUIRE(result.ulpHistogram[0] == reference.size());
+
+    test[1] = std::nextafter(2., 3.);
+    test[3] = -8.001;
+    result = comparison.compare("hice", reference, test);
+    REQUIRE(result.failures == 2);
+    REQUIRE(result.firstFailure == 1);
+    REQUIRE(result.maxAbsolute == Approx(0.001));
+    REQUIRE(result.maxRelative == Approx(0.001 / 8));
+    REQUIRE(result.ulpHistogram[1] == 1);
+
+    // A relative tolerance admits the rounding difference only
+    comparison.setTolerance("hice", { 0, 1e-12 });
+    result = comparison.compare("hice", reference, test);
+    REQUIRE(result.failures == 1);
+    REQUIRE(result.firstFailure == 3);
+    // Other fields keep the default
+    REQUIRE(comparison.compare("cice", reference, test).failures == 2);
+    comparison.setDefaultTolerance({ 0.01, 0 });
+    REQUIRE(comparison.compare("cice", reference, test).passed());
+
+    REQUIRE_THROWS_AS(comparison.compare("hice", reference, { 1 }), std::invalid_argument);
+}
+
+TEST_CASE("NaN values match only NaN values", "[FieldComparison]")
+{
+    FieldComparison comparison(1);
+    comparison.setDefaultTolerance({ 1e10, 1e10 });
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    FieldComparison::Result result = comparison.compare("sst", { nan, inf }, { nan, inf });
+    REQUIRE(result.passed());
+    result = comparison.compare("sst", { 1, 2 }, { 1, nan });
+    REQUIRE(result.failures == 1);
+    REQUIRE(result.ulpHistogram[FieldComparison::ulpBins - 1] == 1);
+}
+
+TEST_CASE("Large fields are compared on several threads", "[FieldComparison]")
+{
+    const size_t size = 1 << 20;
+    std::vector<double> reference(size);
+    for (size_t i = 0; i < size; ++i) {
+        reference[i] = std::sin(0.001 * i);
+    }
+    std::vector<double> test = reference;
+    test[size / 3] += 1;
+    test[size - 1] = std::nextafter(test[size - 1], 2.);
+
+    FieldComparison serial(1);
+    FieldComparison threaded(4);
+    FieldComparison::Result serialResult = serial.compare("tice", reference, test);
+    FieldComparison::Result threadedResult = threaded.compare("tice", reference, test);
+    REQUIRE(threadedResult.failures == 2);
+    REQUIRE(threadedResult.firstFailure == size / 3);
+    REQUIRE(threadedResult.maxAbsolute == serialResult.maxAbsolute);
+    REQUIRE(threadedResult.ulpHistogram == serialResult.ulpHistogram);
+}
+
+TEST_CASE("Read tolerances", "[FieldComparison]")
+{
+    FieldComparison comparison;
+    std::stringstream tolerances;
+    tolerances << "# field absolute relative" << std::endl
+               << "* 1e-12 0" << std::endl
+               << std::endl
+               << "hice 0 1e-6" << std::endl;
+    comparison.readTolerances(tolerances);
+    REQUIRE(comparison.tolerance("hice").relative == 1e-6);
+    REQUIRE(comparison.tolerance("cice").absolute == 1e-12);
+
+    std::stringstream report;
+    comparison.writeReport({ comparison.compare("hice", { 1 }, { 1 }) }, report);
+    REQUIRE(report.str().find("pass") != std::string::npos);
+
+    std::stringstream bad("hice 1e-6");
+    REQUIRE_THROWS_AS(comparison.readTolerances(bad), std::invalid_argument);
+}
+
+} /* namespace Nextsim */
@@ -5,10 +5,18 @@
  */
 
 #include "Iterator.hpp"
+#include "Telemetry.hpp"
+#include "Timer.hpp"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace Nextsim {
 
 // An iterant that counts the number of times it is started, iterated
@@ -64,4 +72,110 @@ TEST_CASE("Count iterator testing", "[Iterator]")
     REQUIRE(cant.stopCount == 1);
 }
 
+TEST_CASE("Number of steps from the time parameters", "[Iterator]")
+{
+    Counterant cant = Counterant();
+    Iterator iterator = Iterator(&cant);
+
+    iterator.parseAndSet("0", "", "86400", "3600");
+    REQUIRE(iterator.nSteps() == 24);
+    REQUIRE(iterator.getTimestep() == 3600);
+
+    // A final partial step is still taken
+    iterator.parseAndSet("0", "7000", "", "3600");
+    REQUIRE(iterator.nSteps() == 2);
+    cant.init();
+    iterator.run();
+    REQUIRE(cant.count == iterator.nSteps());
+}
+
+// An iterant that times its steps in the same way as DevStep
+class TimedIterant : public Iterator::Iterant {
+public:
+    void init() {};
+    void start(const Iterator::TimePoint&) {};
+    void iterate(const Iterator::Duration&)
+    {
+        Timer::main.tick("DevStep");
+        Timer::main.tick("column physics");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        Timer::main.countItems(columns);
+        Timer::main.tock();
+        Timer::main.tock();
+    };
+    void stop(const Iterator::TimePoint&) {};
+
+    static const int columns = 100;
+};
+
+TEST_CASE("Telemetry reports the throughput", "[Iterator]")
+{
+    Timer::main.reset();
+    TimedIterant tant;
+    Iterator iterator(&tant);
+
+    std::stringstream metrics;
+    Telemetry telemetry(metrics, 4);
+    iterator.setTelemetry(&telemetry);
+
+    const int nSteps = 10;
+    const Iterator::Duration dt = 3600;
+    iterator.setStartStopStep(0, nSteps * dt, dt);
+    iterator.run();
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(metrics, line)) {
+        lines.push_back(line);
+    }
+    // Lines after 4 and 8 steps, and the final line
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[0].find("{\"step\": 4, \"model_time\": 14400,") == 0);
+    REQUIRE(lines[1].find("{\"step\": 8, \"model_time\": 28800,") == 0);
+    REQUIRE(lines[2].find("{\"step\": 10, \"model_time\": 36000,") == 0);
+    REQUIRE(lines[1].find("\"final\": false}") != std::string::npos);
+    REQUIRE(lines[2].find("\"final\": true}") != std::string::npos);
+    REQUIRE(lines[2].find("\"eta_s\": 0,") != std::string::npos);
+
+    // Returns the value of a field of a line
+    auto value = [](const std::string& text, const std::string& field) {
+        size_t pos = text.find("\"" + field + "\": ");
+        REQUIRE(pos != std::string::npos);
+        return std::stod(text.substr(pos + field.size() + 4));
+    };
+    // An hour of model time takes at least 2 ms, so at most 5e7 days per day
+    const double sdpd = value(lines[2], "sim_days_per_day");
+    REQUIRE(sdpd > 0);
+    REQUIRE(sdpd < 3600 / 2e-3);
+    REQUIRE(value(lines[2], "sypd") == Approx(sdpd / 365));
+    // At most 100 columns per 2 ms
+    const double columnsPerSecond = value(lines[2], "columns_per_s");
+    REQUIRE(columnsPerSecond > 0);
+    REQUIRE(columnsPerSecond < TimedIterant::columns / 2e-3);
+    // Nearly all the time is spent in the column physics
+    REQUIRE(value(lines[2], "column physics") > 0.5);
+    REQUIRE(value(lines[2], "column physics") <= 1);
+    // The remaining time at the rate of the first four steps
+    REQUIRE(value(lines[0], "eta_s") > 0);
+}
+
+TEST_CASE("Telemetry finishes at the stop time", "[Iterator]")
+{
+    Timer::main.reset();
+    TimedIterant tant;
+    Iterator iterator(&tant);
+
+    std::stringstream metrics;
+    Telemetry telemetry(metrics, 0);
+    iterator.setTelemetry(&telemetry);
+
+    // The last step overshoots the stop time
+    iterator.setStartStopStep(0, 7000, 3600);
+    iterator.run();
+
+    std::string line;
+    std::getline(metrics, line);
+    REQUIRE(line.find("{\"step\": 2, \"model_time\": 7000,") == 0);
+}
+
 } /* namespace Nextsim */
@@ -4,8 +4,189 @@
  * @author Tim Spain <timothy.spain@nersc.no>
  */
 
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
 #include "Logged.hpp"
 
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace Nextsim {
-// TODO: write tests when there is something in the class to test.
+
+// Returns the lines of a log, without the time, level and thread of each
+static std::vector<std::string> messages(const std::string& log)
+{
+    std::vector<std::string> lines;
+    std::stringstream ss(log);
+    std::string line;
+    while (std::getline(ss, line)) {
+        lines.push_back(line.substr(line.find("] ") + 2));
+    }
+    return lines;
+}
+
+TEST_CASE("Levels and formatting", "[Logged]")
+{
+    std::stringstream log;
+    Logged::setStream(log);
+    Logged::setMinimumLevel(Logged::NOTICE);
+
+    REQUIRE(!Logged::isEnabled(Logged::INFO));
+    REQUIRE(Logged::isEnabled(Logged::WARNING));
+
+    Logged::debug("not logged");
+    Logged::info("not logged");
+    Logged::notice("notice ", 1, ' ', -2L, ' ', 3u, ' ', 0.5, ' ', true);
+    Logged::log("warning", Logged::WARNING);
+    Logged::flush();
+
+    REQUIRE(messages(log.str())
+        == std::vector<std::string>({ "notice 1 -2 3 0.5 true", "warning" }));
+    REQUIRE(log.str().find("NOTICE") != std::string::npos);
+    REQUIRE(log.str().find("WARNING") != std::string::npos);
+
+    // Errors are written without flushing
+    log.str("");
+    Logged::error("error");
+    REQUIRE(messages(log.str()) == std::vector<std::string>({ "error" }));
+
+    // Long messages are truncated
+    log.str("");
+    Logged::warning(std::string(Logged::textCapacity + 10, 'x'));
+    Logged::warning(1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3);
+    Logged::flush();
+    std::vector<std::string> truncated = messages(log.str());
+    REQUIRE(truncated.size() == 2);
+    REQUIRE(truncated[0] == std::string(Logged::textCapacity, 'x') + "...");
+    REQUIRE(truncated[1] == "123456789012...");
+
+    REQUIRE(Logged::levelFromString("debug") == Logged::DEBUG);
+    REQUIRE(Logged::levelFromString("CRITICAL") == Logged::CRITICAL);
+    REQUIRE(Logged::levelName(Logged::ALERT) == "ALERT");
+    REQUIRE_THROWS_AS(Logged::levelFromString("verbose"), std::invalid_argument);
+
+    Logged::setMinimumLevel(Logged::INFO);
+    Logged::setStream(std::cout);
+}
+
+TEST_CASE("Logging from several threads", "[Logged]")
+{
+    std::stringstream log;
+    Logged::setStream(log);
+    Logged::setMinimumLevel(Logged::INFO);
+
+    const int nThreads = 4;
+    const int nMessages = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < nMessages; ++i) {
+                Logged::info("thread ", t, " message ", i);
+                // Leave the background thread time to empty the buffers
+                if (i % 100 == 99)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logged::flush();
+
+    // Every message is written, and those of each thread in order
+    std::map<int, int> nextMessage;
+    for (const std::string& message : messages(log.str())) {
+        int t;
+        int i;
+        REQUIRE(std::sscanf(message.c_str(), "thread %d message %d", &t, &i) == 2);
+        REQUIRE(i == nextMessage[t]);
+        ++nextMessage[t];
+    }
+    REQUIRE(nextMessage.size() == nThreads);
+    for (const auto& next : nextMessage) {
+        REQUIRE(next.second == nMessages);
+    }
+
+    Logged::setStream(std::cout);
+}
+
+TEST_CASE("Full buffers drop messages", "[Logged]")
+{
+    std::stringstream log;
+    Logged::setStream(log);
+    Logged::setMinimumLevel(Logged::INFO);
+    Logged::setBufferSize(16);
+
+    const int nMessages = 10000;
+    // A new thread, to log into a buffer of the new size
+    std::thread logger([]() {
+        for (int i = 0; i < nMessages; ++i) {
+            Logged::info("message ", i);
+        }
+    });
+    logger.join();
+    Logged::flush();
+
+    int delivered = 0;
+    int dropped = 0;
+    for (const std::string& message : messages(log.str())) {
+        int n;
+        if (std::sscanf(message.c_str(), "%d messages dropped", &n) == 1) {
+            dropped += n;
+        } else {
+            ++delivered;
+        }
+    }
+    REQUIRE(delivered >= 16);
+    REQUIRE(delivered + dropped == nMessages);
+
+    Logged::setBufferSize(1024);
+    Logged::setStream(std::cout);
+}
+
+// An argument counting its conversions into a message
+class CountedArgument {
+public:
+    operator const char*() const
+    {
+        ++conversions;
+        return "counted";
+    }
+    static int conversions;
+};
+int CountedArgument::conversions = 0;
+
+TEST_CASE("Disabled levels cost nothing", "[Logged]")
+{
+    std::stringstream log;
+    Logged::setStream(log);
+    Logged::setMinimumLevel(Logged::WARNING);
+    CountedArgument::conversions = 0;
+
+    // A disabled message neither converts its arguments nor writes anything
+    const CountedArgument argument;
+    Logged::debug("step ", 1, " of ", argument, " at ", 0.5);
+    Logged::info(argument);
+    Logged::flush();
+    REQUIRE(CountedArgument::conversions == 0);
+    REQUIRE(log.str().empty());
+
+    // An enabled one converts each argument once
+    Logged::warning("step ", 1, " of ", argument);
+    Logged::flush();
+    REQUIRE(CountedArgument::conversions == 1);
+    REQUIRE(log.str().find("step 1 of counted") != std::string::npos);
+
+    Logged::setMinimumLevel(Logged::INFO);
+    Logged::setStream(std::cout);
+}
+
 } /* namespace Nextsim */
@@ -2,9 +2,11 @@
             if (impl == "Impl1") {
                 p_ITest = &i_Impl1;
                 pf_ITest = &newImpl1;
+                s_ITest = sizeof(Impl1);
             } else if (impl == "Impl2") {
                 p_ITest = &i_Impl2;
                 pf_ITest = &newImpl2;
+                s_ITest = sizeof(Impl2);
             } else {
                 throwup(module, impl);
             }
@@ -1,4 +1,10 @@
 static ITest* p_ITest;
+static size_t s_ITest;
+template<>
+size_t ModuleLoader::getInstanceSize<ITest>() const
+{
+    return s_ITest;
+}
 template<>
 ITest& ModuleLoader::getImplementation<ITest>()
 {
@@ -10,6 +16,11 @@ std::unique_ptr<ITest> ModuleLoader::getInstance<ITest>() const
 {
     return (*pf_ITest)();
 }
+template<>
+size_t ModuleLoader::getDecoratorSize<ITest>() const
+{
+    return 0;
+}
 static Impl1 i_Impl1;
 std::unique_ptr<ITest> newImpl1()
 {
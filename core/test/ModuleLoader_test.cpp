@@ -18,7 +18,12 @@ TEST_CASE("Basic module loading test", "[ModuleLoader]")
     REQUIRE(ldr.listModules().size() == 1);
     REQUIRE(ldr.listImplementations("ITest").size() == 2);
 
+    REQUIRE(ldr.getImplementationName("ITest").empty());
+    REQUIRE(ldr.getInstanceSize<ITest>() == 0);
     ldr.setImplementation("ITest", "Impl1");
+    REQUIRE(ldr.getImplementationName("ITest") == "Impl1");
+    REQUIRE(ldr.getInstanceSize<ITest>() == sizeof(Impl1));
+    REQUIRE(ldr.getDecoratorSize<ITest>() == 0);
 
     Impl1 i1;
 
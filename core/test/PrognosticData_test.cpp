@@ -10,6 +10,7 @@
 #include "include/ModuleLoader.hpp"
 #include "include/PrognosticData.hpp"
 #include "include/PrognosticGenerator.hpp"
+#include "include/constants.hpp"
 
 namespace Nextsim {
 
@@ -26,4 +27,30 @@ TEST_CASE("Ice-layer access function", "[PrognosticData]")
     REQUIRE(pd.iceTemperature(2) == tice[2]);
 }
 
+TEST_CASE("Cached freezing point", "[PrognosticData]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    PrognosticData pd(PrognosticGenerator().sss(32.));
+    tryConfigure(pd);
+
+    double sss = 32.;
+    REQUIRE(pd.freezingPoint() == -Water::mu * sss);
+    pd.cacheDerivedQuantities();
+    REQUIRE(pd.freezingPoint() == -Water::mu * sss);
+
+    // Changing the salinity invalidates the cached value
+    sss = 35.;
+    pd.setSeaSurface(-1., sss);
+    REQUIRE(pd.freezingPoint() == -Water::mu * sss);
+    pd.cacheDerivedQuantities();
+    REQUIRE(pd.freezingPoint() == -Water::mu * sss);
+
+    // Changing the implementation invalidates the cached value
+    ModuleLoader::getLoader().setImplementation(
+        "Nextsim::IFreezingPoint", "Nextsim::UnescoFreezing");
+    tryConfigure(pd);
+    REQUIRE(pd.freezingPoint() != -Water::mu * sss);
+    REQUIRE(pd.freezingPoint() == Approx(-1.9223).epsilon(1e-4));
+}
+
 } /* namespace Nextsim */
@@ -0,0 +1,113 @@
+/*!
+ * @file Sampler_test.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Sampler.hpp"
+#include "include/ScopedTimer.hpp"
+#include "include/Timer.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace Nextsim {
+
+// Uses CPU time without sleeping, as SIGPROF is driven by the consumed CPU time
+static double spin(double seconds)
+{
+    double sum = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 1; i < 1000; ++i) {
+            sum += 1. / i;
+        }
+    }
+    return sum;
+}
+
+TEST_CASE("Samples are attributed to the running timers", "[Sampler]")
+{
+    ScopedTimer::setTimerAddress(&Timer::main);
+    Timer::main.reset();
+
+    if (!Sampler::start(1000)) {
+        WARN("Sampling is not available on this system");
+        return;
+    }
+    REQUIRE(Sampler::isRunning());
+    double sum = 0;
+    {
+        ScopedTimer outer("sampled outer");
+        {
+            ScopedTimer inner("sampled inner");
+            sum += spin(0.2);
+        }
+        sum += spin(0.1);
+    }
+    Sampler::stop();
+    REQUIRE_FALSE(Sampler::isRunning());
+    REQUIRE(sum > 0);
+
+    const size_t nSamples = Sampler::samples();
+    REQUIRE(nSamples > 0);
+    REQUIRE(Sampler::dropped() == 0);
+
+    std::stringstream folded;
+    Sampler::writeFolded(folded);
+
+    // Each line ends with a count, and the counts sum to the number of samples
+    size_t total = 0;
+    size_t innerCount = 0;
+    size_t outerCount = 0;
+    std::string line;
+    while (std::getline(folded, line)) {
+        size_t space = line.find_last_of(' ');
+        REQUIRE(space != std::string::npos);
+        size_t count = std::stoul(line.substr(space + 1));
+        total += count;
+        if (line.compare(0, 32, "main;sampled outer;sampled inner") == 0)
+            innerCount += count;
+        else if (line.compare(0, 18, "main;sampled outer") == 0)
+            outerCount += count;
+    }
+    REQUIRE(total == nSamples);
+    REQUIRE(innerCount > 0);
+    REQUIRE(outerCount > 0);
+    // Twice the CPU time was spent in the inner timer
+    REQUIRE(innerCount > outerCount);
+
+    // No more samples are recorded after stopping
+    spin(0.05);
+    REQUIRE(Sampler::samples() == nSamples);
+}
+
+TEST_CASE("Samples beyond the capacity of a thread are dropped", "[Sampler]")
+{
+    ScopedTimer::setTimerAddress(&Timer::main);
+    Timer::main.reset();
+
+    const size_t capacity = 10;
+    if (!Sampler::start(1000, capacity)) {
+        WARN("Sampling is not available on this system");
+        return;
+    }
+    const double sum = spin(0.2);
+    Sampler::stop();
+    REQUIRE(sum > 0);
+
+    // Only this thread was sampled
+    REQUIRE(Sampler::samples() == capacity);
+    REQUIRE(Sampler::dropped() > 0);
+
+    // Starting again discards the samples
+    REQUIRE(Sampler::start(1000, capacity));
+    Sampler::stop();
+    REQUIRE(Sampler::samples() == 0);
+}
+
+} /* namespace Nextsim */
@@ -11,7 +11,9 @@
 
 #include <chrono>
 #include <iostream>
+#include <sstream>
 #include <thread>
+#include <vector>
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
@@ -55,4 +57,33 @@ TEST_CASE("Test the scope dependent timer", "[LocalTimer]")
     std::cout << ScopedTimer::timer() << std::endl;
 }
 
+TEST_CASE("Per-thread timers are merged", "[LocalTimer]")
+{
+    Timer mainTimer("main");
+    ScopedTimer::setTimerAddress(&mainTimer);
+
+    {
+        ScopedTimer parallel("parallel region");
+        const int nThreads = 4;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < nThreads; ++i) {
+            threads.push_back(std::thread([i]() {
+                ScopedTimer work("work");
+                std::this_thread::sleep_for(std::chrono::milliseconds(5 * (i + 1)));
+            }));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        mainTimer.mergeThreadTimers();
+    }
+
+    std::stringstream sout;
+    mainTimer.report("work", sout);
+    std::cout << mainTimer << std::endl;
+    REQUIRE(sout.str().find("work: ticks = 4") == 0);
+    REQUIRE(sout.str().find("across 4 threads") != std::string::npos);
+    REQUIRE(mainTimer.currentTimerNodePath().empty());
+}
+
 } /* namespace Nextsim */
@@ -0,0 +1,77 @@
+/*!
+ * @file TimerAggregator_test.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Timer.hpp"
+#include "include/TimerAggregator.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace Nextsim {
+
+TEST_CASE("Aggregate CSV timer reports", "[TimerAggregator]")
+{
+    std::stringstream rank0;
+    rank0 << "path,ticks,wall_s" << std::endl;
+    rank0 << "main,1,10" << std::endl;
+    rank0 << "main/physics,5,4" << std::endl;
+    rank0 << "\"main/io, restart\",1,1" << std::endl;
+
+    std::stringstream rank1;
+    rank1 << "path,ticks,wall_s" << std::endl;
+    rank1 << "main,1,12" << std::endl;
+    rank1 << "main/physics,5,8" << std::endl;
+
+    TimerAggregator aggregator;
+    aggregator.addCSV(rank0);
+    aggregator.addCSV(rank1);
+
+    REQUIRE(aggregator.reports() == 2);
+    REQUIRE(aggregator.paths().size() == 3);
+    const TimerAggregator::Statistics& physics = aggregator.statistics("main/physics", "wall_s");
+    REQUIRE(physics.count == 2);
+    REQUIRE(physics.min == 4);
+    REQUIRE(physics.max == 8);
+    REQUIRE(physics.mean() == 6);
+    REQUIRE(aggregator.statistics("main/io, restart", "ticks").count == 1);
+
+    std::stringstream out;
+    aggregator.writeCSV(out);
+    std::string header;
+    std::getline(out, header);
+    REQUIRE(header == "path,reports,ticks_min,ticks_max,ticks_mean,wall_s_min,wall_s_max,wall_s_mean");
+    std::string line;
+    std::getline(out, line);
+    REQUIRE(line == "main,2,1,1,1,10,12,11");
+
+    std::stringstream different;
+    different << "path,ticks" << std::endl;
+    REQUIRE_THROWS_AS(aggregator.addCSV(different), std::invalid_argument);
+}
+
+TEST_CASE("Aggregate reports written by Timer", "[TimerAggregator]")
+{
+    TimerAggregator aggregator;
+    for (int rank = 0; rank < 3; ++rank) {
+        Timer timer("rank");
+        for (int i = 0; i <= rank; ++i) {
+            timer.tick("step");
+            timer.tock();
+        }
+        std::stringstream csv;
+        timer.reportCSV(csv);
+        aggregator.addCSV(csv);
+    }
+    const TimerAggregator::Statistics& ticks = aggregator.statistics("rank/step", "ticks");
+    REQUIRE(ticks.min == 1);
+    REQUIRE(ticks.max == 3);
+    REQUIRE(ticks.mean() == 2);
+}
+
+} /* namespace Nextsim */
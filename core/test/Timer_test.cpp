@@ -5,12 +5,15 @@
  * @author Tim Spain
  */
 
+#include "include/Roofline.hpp"
 #include "include/Timer.hpp"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -84,3 +87,225 @@ TEST_CASE("Test the scope dependent timer", "[LocalTimer]")
 
     std::cout << Nextsim::Timer::main << std::endl;
 }
+
+TEST_CASE("Interned timer ids", "[Timer]")
+{
+    Nextsim::Timer::Id physics = Nextsim::Timer::id("physics");
+    REQUIRE(Nextsim::Timer::id("physics") == physics);
+    REQUIRE(Nextsim::Timer::id("dynamics") != physics);
+    REQUIRE(Nextsim::Timer::name(physics) == "physics");
+
+    // Timers started by name and by Id are the same timer
+    Nextsim::Timer timer("root");
+    timer.tick(physics);
+    timer.tock();
+    timer.tick("physics");
+    timer.tock();
+    std::stringstream sout;
+    timer.report("physics", sout);
+    REQUIRE(sout.str().find("physics: ticks = 2") == 0);
+
+    // Additional time on a new path creates the timers on that path
+    timer.additionalTime({ "physics", "thermo" }, std::chrono::milliseconds(10), 0., 3);
+    sout.str("");
+    timer.report("thermo", sout);
+    REQUIRE(sout.str().find("thermo: ticks = 3") == 0);
+    REQUIRE(timer.currentTimerNodePath().empty());
+}
+
+TEST_CASE("Tick overhead is calibrated", "[Timer]")
+{
+    Nextsim::Timer::WallTimeDuration overhead = Nextsim::Timer::calibrate();
+    // The cost of a tick and tock pair depends on the machine, so only its
+    // sign is checked
+    REQUIRE(overhead > Nextsim::Timer::WallTimeDuration::zero());
+    REQUIRE(std::isfinite(std::chrono::duration<double>(overhead).count()));
+    REQUIRE(Nextsim::Timer::overhead() == overhead);
+}
+
+static int countOf(const std::string& text, const std::string& pattern)
+{
+    int count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+TEST_CASE("Trace events are written in the Chrome trace format", "[Timer]")
+{
+    Nextsim::Timer::main.reset();
+    // A ring buffer too small to hold all the events
+    Nextsim::Timer::enableTracing(7);
+    for (int i = 0; i < 5; ++i) {
+        Nextsim::Timer::main.tick("outer");
+        Nextsim::Timer::main.tick("inner \"quoted\"");
+        Nextsim::Timer::main.tock();
+        Nextsim::Timer::main.tock();
+    }
+
+    std::stringstream trace;
+    Nextsim::Timer::writeTrace(trace);
+    Nextsim::Timer::enableTracing(0);
+
+    const std::string json = trace.str();
+    REQUIRE(json.find("{\"traceEvents\":[") == 0);
+    REQUIRE(json.find("inner \\\"quoted\\\"") != std::string::npos);
+    // The last seven events, less the end of an overwritten start event
+    REQUIRE(countOf(json, "\"ph\":\"B\"") == 3);
+    REQUIRE(countOf(json, "\"ph\":\"E\"") == 3);
+
+    // No events are recorded when tracing is disabled
+    Nextsim::Timer::main.tick("outer");
+    Nextsim::Timer::main.tock();
+    trace.str("");
+    Nextsim::Timer::writeTrace(trace);
+    REQUIRE(countOf(trace.str(), "\"ph\"") == 0);
+}
+
+TEST_CASE("Hardware counters degrade gracefully", "[Timer]")
+{
+    Nextsim::Timer::main.reset();
+    bool available = Nextsim::Timer::enableHardwareCounters(true);
+    Nextsim::Timer::main.tick("counted");
+    volatile double sum = 0;
+    for (int i = 0; i < 100000; ++i) {
+        sum = sum + i;
+    }
+    Nextsim::Timer::main.countItems(100000);
+    Nextsim::Timer::main.tock();
+    Nextsim::Timer::enableHardwareCounters(false);
+
+    std::stringstream sout;
+    Nextsim::Timer::main.report("counted", sout);
+    std::cout << sout.str() << std::endl;
+    REQUIRE(sout.str().find("100000 items") != std::string::npos);
+    // Counts are only reported when the counters could be opened
+    REQUIRE((sout.str().find("instructions") != std::string::npos) == available);
+}
+
+TEST_CASE("Lap and elapsed times", "[Timer]")
+{
+    Nextsim::Timer timer("root");
+    timer.tick("sleeper");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(timer.lap("sleeper") >= 0.02);
+    REQUIRE(timer.elapsed("sleeper") >= 0.02);
+    timer.tock();
+    REQUIRE(timer.lap("sleeper") == 0);
+
+    timer.tick("sleeper");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    timer.tock();
+    REQUIRE(timer.elapsed("sleeper") >= 0.03);
+    REQUIRE_THROWS_AS(timer.elapsed("no such timer"), std::out_of_range);
+    REQUIRE_THROWS_AS(timer.items("no such timer"), std::out_of_range);
+
+    // Querying an unknown timer does not intern its name
+    Nextsim::Timer::Id unknown;
+    REQUIRE(!Nextsim::Timer::findId("no such timer", unknown));
+    REQUIRE(Nextsim::Timer::findId("sleeper", unknown));
+    REQUIRE(unknown == Nextsim::Timer::id("sleeper"));
+}
+
+TEST_CASE("JSON and CSV timer reports", "[Timer]")
+{
+    Nextsim::Timer timer("root, \"quoted\"");
+    timer.tick("outer");
+    timer.tick("inner");
+    timer.countItems(10);
+    timer.tock();
+    timer.tock();
+
+    std::stringstream json;
+    timer.reportJSON(json);
+    REQUIRE(json.str().find("{\"name\": \"root, \\\"quoted\\\"\", \"ticks\": 1") == 0);
+    REQUIRE(countOf(json.str(), "\"children\"") == 3);
+    REQUIRE(json.str().find("\"items\": 10") != std::string::npos);
+
+    std::stringstream csv;
+    timer.reportCSV(csv);
+    std::string line;
+    std::getline(csv, line);
+    REQUIRE(line.find("path,ticks,wall_s,cpu_s,") == 0);
+    std::getline(csv, line);
+    REQUIRE(line.find("\"root, \"\"quoted\"\"\",1,") == 0);
+    std::getline(csv, line);
+    REQUIRE(line.find("\"root, \"\"quoted\"\"/outer\",1,") == 0);
+    std::getline(csv, line);
+    REQUIRE(line.find("\"root, \"\"quoted\"\"/outer/inner\",1,") == 0);
+}
+
+// Returns the values of the named columns of one CSV line with a simple path
+static std::vector<double> csvValues(const std::string& header, const std::string& line,
+    const std::vector<std::string>& columnNames)
+{
+    std::vector<std::string> headers;
+    std::vector<std::string> fields;
+    std::stringstream headerStream(header);
+    std::stringstream lineStream(line);
+    std::string field;
+    while (std::getline(headerStream, field, ','))
+        headers.push_back(field);
+    while (std::getline(lineStream, field, ','))
+        fields.push_back(field);
+    std::vector<double> values;
+    for (auto& name : columnNames) {
+        size_t index = std::find(headers.begin(), headers.end(), name) - headers.begin();
+        values.push_back(std::stod(fields.at(index)));
+    }
+    return values;
+}
+
+TEST_CASE("Work is reported as rates", "[Timer]")
+{
+    Nextsim::Timer timer("root");
+    timer.tick("stage");
+    timer.addWork(3e6, 1e6);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    timer.addWork(1e6, 1e6);
+    timer.tock();
+    const double wall = timer.elapsed("stage");
+
+    const std::vector<std::string> names = { "bytes", "flops", "GB_per_s", "GFLOP_per_s",
+        "percent_of_peak_bandwidth", "percent_of_peak_flops" };
+    std::stringstream csv;
+    std::string header;
+    std::string line;
+    timer.reportCSV(csv);
+    std::getline(csv, header);
+    std::getline(csv, line);
+    std::getline(csv, line);
+    std::vector<double> values = csvValues(header, line, names);
+    REQUIRE(values[0] == 4e6);
+    REQUIRE(values[1] == 2e6);
+    REQUIRE(values[2] == Approx(4e-3 / wall).epsilon(1e-3));
+    REQUIRE(values[3] == Approx(2e-3 / wall).epsilon(1e-3));
+    // No peak has been set
+    REQUIRE(values[4] == 0);
+    REQUIRE(values[5] == 0);
+
+    // Set the peak to twice the achieved rates
+    Nextsim::Timer::setPeak(8e6 / wall, 4e6 / wall);
+    csv.str("");
+    timer.reportCSV(csv);
+    std::getline(csv, header);
+    std::getline(csv, line);
+    std::getline(csv, line);
+    values = csvValues(header, line, names);
+    REQUIRE(values[4] == Approx(50).epsilon(1e-3));
+    REQUIRE(values[5] == Approx(50).epsilon(1e-3));
+
+    std::stringstream text;
+    timer.report(text);
+    REQUIRE(text.str().find("GB/s (") != std::string::npos);
+    REQUIRE(text.str().find("GFLOP/s (") != std::string::npos);
+    Nextsim::Timer::setPeak(0, 0);
+}
+
+TEST_CASE("The roofline probes measure positive rates", "[Timer]")
+{
+    REQUIRE(Nextsim::Roofline::bandwidth(1 << 16, 2) > 0);
+    REQUIRE(Nextsim::Roofline::flopRate(1 << 12, 2) > 0);
+}
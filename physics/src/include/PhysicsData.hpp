@@ -8,9 +8,13 @@
 #define SRC_INCLUDE_PHYSICSDATA_HPP
 
 #include "include/BaseElementData.hpp"
+#include "include/ExternalData.hpp"
 #include "include/IPrognosticUpdater.hpp"
+#include "include/Precision.hpp"
 #include "include/PrognosticData.hpp"
 
+#include <array>
+#include <limits>
 #include <vector>
 namespace Nextsim {
 
@@ -34,26 +38,30 @@ public:
         , m_hs(0)
         , m_TiceNew(nIceLayers, 0.)
     {
+        // NaN compares unequal to any value, so all inputs start as changed
+        m_derivedInputs.fill(std::numeric_limits<double>::quiet_NaN());
     }
 
     ~PhysicsData() = default;
 
     //! Density of air at the current temperature and humidity [kg m⁻³]
-    inline double& airDensity() { return m_rho; };
+    inline Precision::Diagnostic& airDensity() { return m_rho; };
     //! Wind speed [m s⁻¹]
-    inline double& windSpeed() { return m_wspeed; }
+    inline Precision::Diagnostic& windSpeed() { return m_wspeed; }
+    //! Wind speed [m s⁻¹]
+    inline double windSpeed() const { return m_wspeed; }
     //! Specific humidity over the water [kg kg⁻¹]
-    inline double& specificHumidityWater() { return m_sphumw; }
+    inline Precision::Diagnostic& specificHumidityWater() { return m_sphumw; }
     //! Specific humidity over the ice [kg kg⁻¹]
-    inline double& specificHumidityIce() { return m_sphumi; }
+    inline Precision::Diagnostic& specificHumidityIce() { return m_sphumi; }
     //! Specific humidity of the air [kg kg⁻¹]
-    inline double& specificHumidityAir() { return m_sphuma; }
+    inline Precision::Diagnostic& specificHumidityAir() { return m_sphuma; }
     //! Mixing ratio of water vapour in the air [kg kg⁻¹]
     inline double mixingRatio() { return m_sphuma / (1 - m_sphuma); }
     //! Specific heat capacity of wet air [J kg⁻¹ K⁻¹]
-    inline double& heatCapacityWetAir() { return m_cspec; }
+    inline Precision::Diagnostic& heatCapacityWetAir() { return m_cspec; }
     //! Pressure due to wind drag [Pa]
-    inline double& dragPressure() { return m_tau; }
+    inline Precision::Diagnostic& dragPressure() { return m_tau; }
 
     //! True ice thickness as updated [m]
     inline double& updatedIceTrueThickness() { return m_hi_new; }
@@ -75,20 +83,59 @@ public:
     //! Updated value of the ice concentration [1]
     double updatedIceConcentration() const override { return m_conc_new; }
 
+    //! Bit flags for the input fields that the derived physics data depends on.
+    enum DerivedInput {
+        AIR_TEMPERATURE = 1 << 0,
+        DEW_POINT = 1 << 1,
+        AIR_PRESSURE = 1 << 2,
+        SEA_SURFACE_TEMPERATURE = 1 << 3,
+        SEA_SURFACE_SALINITY = 1 << 4,
+        ICE_SURFACE_TEMPERATURE = 1 << 5,
+    };
+
+    /*!
+     * @brief Records the current values of the inputs of the derived data.
+     *
+     * @details Returns the DerivedInput flags of the inputs which have
+     * changed since the previous call.
+     *
+     * @param prog PrognosticData for this element (constant).
+     * @param exter ExternalData for this element (constant).
+     */
+    inline unsigned int updateDerivedInputs(const PrognosticData& prog, const ExternalData& exter)
+    {
+        const std::array<double, nDerivedInputs> current = { exter.airTemperature(),
+            exter.dewPoint2m(), exter.airPressure(), prog.seaSurfaceTemperature(),
+            prog.seaSurfaceSalinity(), prog.iceTemperature(0) };
+        unsigned int changed = 0;
+        for (int i = 0; i < nDerivedInputs; ++i) {
+            if (current[i] != m_derivedInputs[i]) {
+                changed |= 1 << i;
+                m_derivedInputs[i] = current[i];
+            }
+        }
+        return changed;
+    }
+
 private:
-    double m_rho;
-    double m_wspeed;
-    double m_sphumw;
-    double m_sphumi;
-    double m_sphuma;
-    double m_cspec;
-    double m_tau;
+    // diagnostic values
+    Precision::Diagnostic m_rho;
+    Precision::Diagnostic m_wspeed;
+    Precision::Diagnostic m_sphumw;
+    Precision::Diagnostic m_sphumi;
+    Precision::Diagnostic m_sphuma;
+    Precision::Diagnostic m_cspec;
+    Precision::Diagnostic m_tau;
 
     // thermodynamic values
     double m_hi_new; // updated true ice thickness [m]
     double m_hs;
     std::vector<double> m_TiceNew;
     double m_conc_new; // updated ice concentration
+
+    // Values of the inputs when the derived data was last calculated
+    static const int nDerivedInputs = 6;
+    std::array<double, nDerivedInputs> m_derivedInputs;
 };
 
 } /* namespace Nextsim */
@@ -38,10 +38,16 @@ IIceAlbedo* NextsimPhysics::iIceAlbedoImpl = nullptr;
 IThermodynamics* NextsimPhysics::iThermo = nullptr;
 IConcentrationModel* NextsimPhysics::iConcentrationModelImpl = nullptr;
 
+thread_local NextsimPhysics::FluxScratch NextsimPhysics::scratch;
+
 double stefanBoltzmannLaw(double temperature);
 
 NextsimPhysics::NextsimPhysics()
-    : m_Qio(0)
+    : m_subl(0)
+    , m_dQ_dT(0)
+    , m_Qio(0)
+    , m_Qia(0)
+    , m_hifroms(0)
     , m_newice(0)
 {
 }
@@ -113,7 +119,7 @@ void NextsimPhysics::updateHeatCapacityWetAir(const ExternalData& exter, Physics
     phys.heatCapacityWetAir() = Air::cp + phys.specificHumidityAir() * Vapour::cp;
 };
 
-void NextsimPhysics::calculate(
+void NextsimPhysics::calculateFluxes(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
     massFluxOpenWater(phys);
@@ -124,8 +130,13 @@ void NextsimPhysics::calculate(
     // Ice momentum fluxes are handled by the dynamics
     heatFluxIceAtmosphere(prog, exter, phys);
 
-    // The mass flux is driven by the heat flux, so that is called first
+    // The mass flux is driven by the heat flux, so that is calculated first
     heatFluxIceOcean(prog, exter, phys);
+}
+
+void NextsimPhysics::calculateThermodynamics(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
     // Ice momentum fluxes are handled by the dynamics
     massFluxIceOcean(prog, exter, phys);
 }
@@ -133,7 +144,7 @@ void NextsimPhysics::calculate(
 void NextsimPhysics::massFluxOpenWater(PhysicsData& phys)
 {
     double specificHumidityDifference = phys.specificHumidityWater() - phys.specificHumidityAir();
-    m_evap = dragOcean_q * phys.airDensity() * phys.windSpeed() * specificHumidityDifference;
+    scratch.evap = dragOcean_q * phys.airDensity() * phys.windSpeed() * specificHumidityDifference;
 }
 
 void NextsimPhysics::momentumFluxOpenWater(PhysicsData& phys)
@@ -145,20 +156,20 @@ void NextsimPhysics::heatFluxOpenWater(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
     // Latent heat flux from evaporation and condensation
-    m_Qlhow = m_evap * latentHeatWater(prog.seaSurfaceTemperature());
+    scratch.Qlhow = scratch.evap * latentHeatWater(prog.seaSurfaceTemperature());
 
     // Sensible heat flux
-    m_Qshow = dragOcean_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed()
+    scratch.Qshow = dragOcean_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed()
         * (prog.seaSurfaceTemperature() - exter.airTemperature());
 
     // Shortwave flux
-    m_Qswow = -exter.incomingShortwave() * (1 - m_oceanAlbedo);
+    scratch.Qswow = -exter.incomingShortwave() * (1 - m_oceanAlbedo);
 
     // Longwave flux
-    m_Qlwow = stefanBoltzmannLaw(prog.seaSurfaceTemperature()) - exter.incomingLongwave();
+    scratch.Qlwow = stefanBoltzmannLaw(prog.seaSurfaceTemperature()) - exter.incomingLongwave();
 
     // Total flux
-    m_Qow = m_Qlhow + m_Qshow + m_Qlwow + m_Qswow;
+    scratch.Qow = scratch.Qlhow + scratch.Qshow + scratch.Qlwow + scratch.Qswow;
 }
 
 void NextsimPhysics::massFluxIceAtmosphere(const PrognosticData& prog, PhysicsData& phys)
@@ -170,29 +181,33 @@ void NextsimPhysics::massFluxIceAtmosphere(const PrognosticData& prog, PhysicsDa
 void NextsimPhysics::heatFluxIceAtmosphere(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
+    // Quantities used by more than one flux term
+    const double iceSurfaceTemperature = prog.iceTemperature(0);
+    const double latentHeatSurface = latentHeatIce(iceSurfaceTemperature);
+    const double emittedLongwave = stefanBoltzmannLaw(iceSurfaceTemperature);
+    const double transferCoefficient = dragIce_t * phys.airDensity() * phys.windSpeed();
+
     // Latent heat flux from sublimation
-    m_Qlhi = m_subl * latentHeatIce(prog.iceTemperature(0));
-    double dmdot_dT = dragIce_t * phys.airDensity() * phys.windSpeed()
-        * specHumIce.dq_dT(prog.iceTemperature(0), exter.airPressure());
-    double dQlh_dT = latentHeatIce(prog.iceTemperature(0)) * dmdot_dT;
+    scratch.Qlhi = m_subl * latentHeatSurface;
+    double dmdot_dT
+        = transferCoefficient * specHumIce.dq_dT(iceSurfaceTemperature, exter.airPressure());
+    double dQlh_dT = latentHeatSurface * dmdot_dT;
 
     // Sensible heat flux
-    m_Qshi = dragIce_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed()
-        * (prog.iceTemperature(0) - exter.airTemperature());
-    double dQsh_dT = dragIce_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed();
+    double dQsh_dT = transferCoefficient * phys.heatCapacityWetAir();
+    scratch.Qshi = dQsh_dT * (iceSurfaceTemperature - exter.airTemperature());
 
     // Shortwave flux
-    double albedoValue = iIceAlbedoImpl->albedo(prog.iceTemperature(0),
+    double albedoValue = iIceAlbedoImpl->albedo(iceSurfaceTemperature,
         (prog.iceConcentration() > 0) ? (prog.snowThickness() / prog.iceConcentration()) : 0.);
-    m_Qswi = -exter.incomingShortwave() * (1. - m_I0) * (1 - albedoValue);
+    scratch.Qswi = -exter.incomingShortwave() * (1. - m_I0) * (1 - albedoValue);
 
     // Longwave flux
-    m_Qlwi = stefanBoltzmannLaw(prog.iceTemperature(0)) - exter.incomingLongwave();
-    double dQlw_dT
-        = 4 / kelvin(prog.iceTemperature(0)) * stefanBoltzmannLaw(prog.iceTemperatures()[0]);
+    scratch.Qlwi = emittedLongwave - exter.incomingLongwave();
+    double dQlw_dT = 4 / kelvin(iceSurfaceTemperature) * emittedLongwave;
 
     // Total flux
-    m_Qia = m_Qlhi + m_Qshi + m_Qlwi + m_Qswi;
+    m_Qia = scratch.Qlhi + scratch.Qshi + scratch.Qlwi + scratch.Qswi;
     // Overall temperature dependence of flux
     m_dQ_dT = dQlh_dT + dQsh_dT + dQlw_dT;
 }
@@ -209,7 +224,7 @@ void NextsimPhysics::massFluxIceOcean(
 
     // Apply the lower limit of concentration and thickness
     if (phys.updatedIceConcentration() < minc || phys.updatedIceTrueThickness() < minh) {
-        m_Qow += phys.updatedIceConcentration() * Water::Lf
+        scratch.Qow += phys.updatedIceConcentration() * Water::Lf
             * (phys.updatedIceTrueThickness() * Ice::rho
                 + phys.updatedSnowTrueThickness() * Ice::rhoSnow)
             / prog.timestep();
@@ -230,7 +245,7 @@ void NextsimPhysics::newIceFormation(
 {
     // Flux cooling the ocean from open water
     // TODO Add assimilation fluxes here
-    double coolingFlux = m_Qow;
+    double coolingFlux = scratch.Qow;
     // Temperature change of the mixed layer during this timestep
     double deltaTml = -coolingFlux / exter.mixedLayerBulkHeatCapacity() * prog.timestep();
     // Initial temperature
@@ -247,7 +262,7 @@ void NextsimPhysics::newIceFormation(
         // Any heat beyond that is latent heat forming new ice
         double latentFlux = coolingFlux - sensibleFlux;
 
-        m_Qow = sensibleFlux;
+        scratch.Qow = sensibleFlux;
         m_newice
             = latentFlux * prog.timestep() * (1 - prog.iceConcentration()) / (Ice::Lf * Ice::rho);
     }
@@ -279,7 +294,7 @@ void NextsimPhysics::lateralGrowth(
 
         if (del_c < 0) {
             // Snow is lost if the concentration decreases, and energy is returned to the ocean
-            m_Qow -= del_c * phys.updatedSnowTrueThickness() * Water::Lf * Ice::rhoSnow
+            scratch.Qow -= del_c * phys.updatedSnowTrueThickness() * Water::Lf * Ice::rhoSnow
                 / prog.timestep();
         } else {
             // Currently no new snow is implemented
@@ -11,6 +11,9 @@
 #include "include/PhysicsData.hpp"
 #include "include/PrognosticData.hpp"
 
+#include <array>
+#include <ostream>
+
 namespace Nextsim {
 
 class ExternalData;
@@ -20,11 +23,79 @@ class IPhysics1d {
 public:
     virtual ~IPhysics1d() = default;
 
+    //! The derived fields calculated by updateDerivedData().
+    enum DerivedField {
+        SPECIFIC_HUMIDITY_AIR,
+        SPECIFIC_HUMIDITY_WATER,
+        SPECIFIC_HUMIDITY_ICE,
+        AIR_DENSITY,
+        HEAT_CAPACITY_WET_AIR,
+        N_DERIVED_FIELDS,
+    };
+
+    //! A class counting the derived fields recalculated since the last reset.
+    class DerivedDataReport {
+    public:
+        DerivedDataReport() { reset(); }
+
+        //! Zeros all the counts.
+        void reset()
+        {
+            m_columns = 0;
+            m_counts.fill(0);
+        }
+        //! Counts one column being processed.
+        void countColumn() { ++m_columns; }
+        //! Counts one recalculation of a derived field.
+        void countRecalculation(DerivedField field) { ++m_counts[field]; }
+
+        //! The number of columns processed.
+        int columns() const { return m_columns; }
+        //! The number of columns where the derived field was recalculated.
+        int recalculated(DerivedField field) const { return m_counts[field]; }
+
+        /*!
+         * @brief Prints the recalculation counts of all fields to an ostream.
+         *
+         * @param os The ostream to print to.
+         */
+        std::ostream& report(std::ostream& os) const
+        {
+            os << "Derived data recalculated in " << m_columns << " columns:";
+            for (int i = 0; i < N_DERIVED_FIELDS; ++i) {
+                os << " " << fieldName(static_cast<DerivedField>(i)) << " = " << m_counts[i];
+            }
+            return os;
+        }
+
+        //! The name of a derived field.
+        static const char* fieldName(DerivedField field)
+        {
+            static const std::array<const char*, N_DERIVED_FIELDS> names
+                = { "specificHumidityAir", "specificHumidityWater", "specificHumidityIce",
+                      "airDensity", "heatCapacityWetAir" };
+            return names[field];
+        }
+
+    private:
+        int m_columns;
+        std::array<int, N_DERIVED_FIELDS> m_counts;
+    };
+
+    //! Returns the report of the derived data recalculations made by the calling thread.
+    static DerivedDataReport& derivedDataReport()
+    {
+        thread_local DerivedDataReport report;
+        return report;
+    }
+
     /*!
      * @brief Updates any derived quantities in PhysicsData.
      *
      * @details This function is declared virtual to be overridden if the implementing class needs to update
-     * any class specific derived data.
+     * any class specific derived data. Each derived field is only
+     * recalculated if one of the inputs it depends on has changed since the
+     * previous update of this element.
      *
      * @param prog PrognosticData for this element (constant).
      * @param exter ExternalData for this element (constant).
@@ -33,12 +104,33 @@ public:
     virtual void updateDerivedData(
         const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
     {
-        updateSpecificHumidityAir(exter, phys);
-        updateSpecificHumidityWater(prog, exter, phys);
-        updateSpecificHumidityIce(prog, exter, phys);
+        const unsigned int changed = phys.updateDerivedInputs(prog, exter);
+        DerivedDataReport& report = derivedDataReport();
+        report.countColumn();
+
+        // Specific humidity of the air, and the fields that depend on it
+        const unsigned int airHumidityInputs = PhysicsData::DEW_POINT | PhysicsData::AIR_PRESSURE;
+        if (changed & airHumidityInputs) {
+            updateSpecificHumidityAir(exter, phys);
+            report.countRecalculation(SPECIFIC_HUMIDITY_AIR);
 
-        updateAirDensity(exter, phys);
-        updateHeatCapacityWetAir(exter, phys);
+            updateHeatCapacityWetAir(exter, phys);
+            report.countRecalculation(HEAT_CAPACITY_WET_AIR);
+        }
+        if (changed & (airHumidityInputs | PhysicsData::AIR_TEMPERATURE)) {
+            updateAirDensity(exter, phys);
+            report.countRecalculation(AIR_DENSITY);
+        }
+        if (changed
+            & (PhysicsData::SEA_SURFACE_TEMPERATURE | PhysicsData::SEA_SURFACE_SALINITY
+                | PhysicsData::AIR_PRESSURE)) {
+            updateSpecificHumidityWater(prog, exter, phys);
+            report.countRecalculation(SPECIFIC_HUMIDITY_WATER);
+        }
+        if (changed & (PhysicsData::ICE_SURFACE_TEMPERATURE | PhysicsData::AIR_PRESSURE)) {
+            updateSpecificHumidityIce(prog, exter, phys);
+            report.countRecalculation(SPECIFIC_HUMIDITY_ICE);
+        }
 
         phys.updatedSnowTrueThickness() = prog.snowTrueThickness();
         phys.updatedIceTrueThickness() = prog.iceTrueThickness();
@@ -48,13 +140,37 @@ public:
      * @brief Performs the 1d physics calculation.
      *
      * @details Performs the one-dimensional physics calculation for this
-     * element, writing the data to the PhysicsData argument.
+     * element, writing the data to the PhysicsData argument: the fluxes,
+     * followed by the thermodynamics that they drive.
+     *
+     * @param prog PrognosticData for this element (constant).
+     * @param exter ExternalData for this element (constant).
+     * @param phys PhysicsData for this element.
+     */
+    virtual void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+    {
+        calculateFluxes(prog, exter, phys);
+        calculateThermodynamics(prog, exter, phys);
+    }
+
+    /*!
+     * @brief Calculates the fluxes between the ocean, ice and atmosphere.
      *
      * @param prog PrognosticData for this element (constant).
      * @param exter ExternalData for this element (constant).
      * @param phys PhysicsData for this element.
      */
-    virtual void calculate(const PrognosticData&, const ExternalData&, PhysicsData&) = 0;
+    virtual void calculateFluxes(const PrognosticData&, const ExternalData&, PhysicsData&) = 0;
+    /*!
+     * @brief Updates the ice and snow with the fluxes of the last call to
+     * calculateFluxes() on the same thread.
+     *
+     * @param prog PrognosticData for this element (constant).
+     * @param exter ExternalData for this element (constant).
+     * @param phys PhysicsData for this element.
+     */
+    virtual void calculateThermodynamics(const PrognosticData&, const ExternalData&, PhysicsData&)
+        = 0;
 
 protected:
     /*!
@@ -46,10 +46,9 @@ public:
         MINH_KEY,
     };
 
-    void calculate(const PrognosticData&, const ExternalData&, PhysicsData&) override;
+    void calculateFluxes(const PrognosticData&, const ExternalData&, PhysicsData&) override;
+    void calculateThermodynamics(const PrognosticData&, const ExternalData&, PhysicsData&) override;
 
-    //! Calculate the new ice formed this timestep on open water
-    void newIceFormation(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
     //! The thickness of newly created ice in the current timestep
     inline double newIce() const { return m_newice; };
 
@@ -215,24 +214,40 @@ private:
     void massFluxIceOcean(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
     void heatFluxIceOcean(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
     void lateralGrowth(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+    // Calculate the new ice formed this timestep on open water, which uses
+    // the open water heat flux of calculateFluxes()
+    void newIceFormation(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+
+    /*
+     * Fluxes which only exist from a call to calculateFluxes() to the
+     * following call to calculateThermodynamics() on the same thread.
+     * These are held per thread rather than per element, so that the
+     * per-element state is only the values read by the other physics
+     * modules through the accessors above.
+     */
+    struct FluxScratch {
+        // Phase change rates
+        double evap;
+
+        // Open water heat fluxes
+        double Qow;
+        double Qlwow;
+        double Qswow;
+        double Qlhow;
+        double Qshow;
+
+        // Ice heat fluxes
+        double Qlwi;
+        double Qswi;
+        double Qlhi;
+        double Qshi;
+    };
+    static thread_local FluxScratch scratch;
 
     // Phase change rates
-    double m_evap;
     double m_subl;
 
-    // Open water heat fluxes
-    double m_Qow;
-    double m_Qlwow;
-    double m_Qswow;
-    double m_Qlhow;
-    double m_Qshow;
-
     // Ice heat fluxes
-    double m_Qi;
-    double m_Qlwi;
-    double m_Qswi;
-    double m_Qlhi;
-    double m_Qshi;
     double m_dQ_dT;
 
     // ice-ocean fluxes
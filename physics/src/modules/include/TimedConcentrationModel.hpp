@@ -0,0 +1,41 @@
+/*!
+ * @file TimedConcentrationModel.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDCONCENTRATIONMODEL_HPP
+#define SRC_INCLUDE_TIMEDCONCENTRATIONMODEL_HPP
+
+#include "IConcentrationModel.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the ice concentration update calculations.
+class TimedConcentrationModel : public TimedModule<IConcentrationModel> {
+public:
+    using TimedModule<IConcentrationModel>::TimedModule;
+
+    double freeze(
+        const PrognosticData& prog, PhysicsData& phys, NextsimPhysics& nsphys) const override
+    {
+        static const Timer::Id timerId = Timer::id("IConcentrationModel::freeze");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        return p_impl->freeze(prog, phys, nsphys);
+    }
+
+    double melt(
+        const PrognosticData& prog, PhysicsData& phys, NextsimPhysics& nsphys) const override
+    {
+        static const Timer::Id timerId = Timer::id("IConcentrationModel::melt");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        return p_impl->melt(prog, phys, nsphys);
+    }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDCONCENTRATIONMODEL_HPP */
@@ -0,0 +1,31 @@
+/*!
+ * @file TimedIceAlbedo.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDICEALBEDO_HPP
+#define SRC_INCLUDE_TIMEDICEALBEDO_HPP
+
+#include "IIceAlbedo.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the ice surface albedo calculation.
+class TimedIceAlbedo : public TimedModule<IIceAlbedo> {
+public:
+    using TimedModule<IIceAlbedo>::TimedModule;
+
+    double albedo(double temperature, double snowThickness) override
+    {
+        static const Timer::Id timerId = Timer::id("IIceAlbedo::albedo");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        return p_impl->albedo(temperature, snowThickness);
+    }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDICEALBEDO_HPP */
@@ -0,0 +1,32 @@
+/*!
+ * @file TimedIceOceanHeatFlux.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDICEOCEANHEATFLUX_HPP
+#define SRC_INCLUDE_TIMEDICEOCEANHEATFLUX_HPP
+
+#include "IIceOceanHeatFlux.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the ice-ocean heat flux calculation.
+class TimedIceOceanHeatFlux : public TimedModule<IIceOceanHeatFlux> {
+public:
+    using TimedModule<IIceOceanHeatFlux>::TimedModule;
+
+    double flux(const PrognosticData& prog, const ExternalData& exter, const PhysicsData& phys,
+        const NextsimPhysics& nsphys) override
+    {
+        static const Timer::Id timerId = Timer::id("IIceOceanHeatFlux::flux");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        return p_impl->flux(prog, exter, phys, nsphys);
+    }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDICEOCEANHEATFLUX_HPP */
@@ -0,0 +1,74 @@
+/*!
+ * @file TimedPhysics1d.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDPHYSICS1D_HPP
+#define SRC_INCLUDE_TIMEDPHYSICS1D_HPP
+
+#include "IPhysics1d.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the column ice physics.
+class TimedPhysics1d : public TimedModule<IPhysics1d> {
+public:
+    using TimedModule<IPhysics1d>::TimedModule;
+
+    void updateDerivedData(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys) override
+    {
+        static const Timer::Id timerId = Timer::id("IPhysics1d::updateDerivedData");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        p_impl->updateDerivedData(prog, exter, phys);
+    }
+
+    void calculate(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys) override
+    {
+        static const Timer::Id timerId = Timer::id("IPhysics1d::calculate");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        p_impl->calculate(prog, exter, phys);
+    }
+
+    void calculateFluxes(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys) override
+    {
+        static const Timer::Id timerId = Timer::id("IPhysics1d::calculateFluxes");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        p_impl->calculateFluxes(prog, exter, phys);
+    }
+
+    void calculateThermodynamics(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys) override
+    {
+        static const Timer::Id timerId = Timer::id("IPhysics1d::calculateThermodynamics");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        p_impl->calculateThermodynamics(prog, exter, phys);
+    }
+
+protected:
+    // The derived data are updated by the wrapped implementation, so these
+    // are never called
+    void updateSpecificHumidityAir(const ExternalData&, PhysicsData&) override { }
+    void updateSpecificHumidityWater(
+        const PrognosticData&, const ExternalData&, PhysicsData&) override
+    {
+    }
+    void updateSpecificHumidityIce(
+        const PrognosticData&, const ExternalData&, PhysicsData&) override
+    {
+    }
+    void updateAirDensity(const ExternalData&, PhysicsData&) override { }
+    void updateHeatCapacityWetAir(const ExternalData&, PhysicsData&) override { }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDPHYSICS1D_HPP */
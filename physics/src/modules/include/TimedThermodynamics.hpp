@@ -0,0 +1,32 @@
+/*!
+ * @file TimedThermodynamics.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef SRC_INCLUDE_TIMEDTHERMODYNAMICS_HPP
+#define SRC_INCLUDE_TIMEDTHERMODYNAMICS_HPP
+
+#include "IThermodynamics.hpp"
+#include "include/ModuleTiming.hpp"
+
+namespace Nextsim {
+
+//! The timing decorator of the ice thermodynamics.
+class TimedThermodynamics : public TimedModule<IThermodynamics> {
+public:
+    using TimedModule<IThermodynamics>::TimedModule;
+
+    void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys,
+        NextsimPhysics& nsphys) override
+    {
+        static const Timer::Id timerId = Timer::id("IThermodynamics::calculate");
+        static thread_local int calls = 0;
+        ModuleTiming::Sample sample(timerId, calls);
+        p_impl->calculate(prog, exter, phys, nsphys);
+    }
+};
+
+}
+
+#endif /* SRC_INCLUDE_TIMEDTHERMODYNAMICS_HPP */
@@ -8,12 +8,17 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 #include <sstream>
+#include <vector>
 
 #include "include/ConfiguredModule.hpp"
 #include "include/ElementData.hpp"
 #include "include/IIceAlbedo.hpp"
 #include "include/ModuleLoader.hpp"
+#include "include/ModuleTiming.hpp"
 #include "include/NextsimPhysics.hpp"
+#include "include/ScopedTimer.hpp"
+#include "include/TimedIceAlbedo.hpp"
+#include "include/Timer.hpp"
 #include "include/constants.hpp"
 
 namespace Nextsim {
@@ -63,9 +68,9 @@ TEST_CASE("Update derived data", "[NextsimPhysics]")
     double cice = 0.5;
 
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
 
     NextsimPhysics nsData;
     nsData.updateDerivedData(data, data, data);
@@ -77,6 +82,59 @@ TEST_CASE("Update derived data", "[NextsimPhysics]")
     REQUIRE(1011.81 == Approx(data.heatCapacityWetAir()).epsilon(1e-4));
 }
 
+TEST_CASE("Derived data is only recalculated when its inputs change", "[NextsimPhysics]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+
+    ElementData data;
+    data.configure();
+
+    data = PrognosticGenerator().hice(0.1).cice(0.5).sst(-1).sss(32).hsnow(0.).tice({ -2. });
+    data.setAirTemperature(-3);
+    data.setDewPoint2m(0.1);
+    data.setAirPressure(100000);
+
+    IPhysics1d::DerivedDataReport& report = IPhysics1d::derivedDataReport();
+    report.reset();
+
+    NextsimPhysics nsData;
+    nsData.updateDerivedData(data, data, data);
+    double airDensity = data.airDensity();
+    REQUIRE(report.columns() == 1);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_AIR) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_WATER) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_ICE) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::AIR_DENSITY) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::HEAT_CAPACITY_WET_AIR) == 1);
+
+    // Unchanged inputs
+    nsData.updateDerivedData(data, data, data);
+    REQUIRE(report.columns() == 2);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_AIR) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::AIR_DENSITY) == 1);
+    REQUIRE(data.airDensity() == airDensity);
+
+    // Only the air density depends on the air temperature
+    data.setAirTemperature(-5);
+    nsData.updateDerivedData(data, data, data);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_AIR) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_WATER) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_ICE) == 1);
+    REQUIRE(report.recalculated(IPhysics1d::AIR_DENSITY) == 2);
+    REQUIRE(report.recalculated(IPhysics1d::HEAT_CAPACITY_WET_AIR) == 1);
+    REQUIRE(data.airDensity() > airDensity);
+
+    // The pressure affects everything
+    data.setAirPressure(101000);
+    nsData.updateDerivedData(data, data, data);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_AIR) == 2);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_WATER) == 2);
+    REQUIRE(report.recalculated(IPhysics1d::SPECIFIC_HUMIDITY_ICE) == 2);
+    REQUIRE(report.recalculated(IPhysics1d::AIR_DENSITY) == 3);
+    REQUIRE(report.recalculated(IPhysics1d::HEAT_CAPACITY_WET_AIR) == 2);
+}
+
 TEST_CASE("New ice formation", "[NextsimPhysics]")
 {
     std::stringstream config;
@@ -105,12 +163,12 @@ TEST_CASE("New ice formation", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
     data.setTimestep(86400.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 0;
-    data.incomingShortwave() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(0);
+    data.setIncomingShortwave(0);
 
     NextsimPhysics nsphys;
     nsphys.configure();
@@ -144,12 +202,12 @@ TEST_CASE("Drag pressure", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
     data.setTimestep(86400.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 0;
-    data.incomingShortwave() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(0);
+    data.setIncomingShortwave(0);
 
     NextsimPhysics nsphys;
 
@@ -209,13 +267,13 @@ TEST_CASE("Melting conditions", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(tice);
     data.setTimestep(600.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 330;
-    data.incomingShortwave() = 50;
-    data.snowfall() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(330);
+    data.setIncomingShortwave(50);
+    data.setSnowfall(0);
 
     data.windSpeed() = 5;
 
@@ -278,13 +336,13 @@ TEST_CASE("Freezing conditions", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(tice);
     data.setTimestep(600.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 265;
-    data.incomingShortwave() = 0;
-    data.snowfall() = 1e-3;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(265);
+    data.setIncomingShortwave(0);
+    data.setSnowfall(1e-3);
 
     data.windSpeed() = 5;
 
@@ -310,4 +368,141 @@ TEST_CASE("Freezing conditions", "[NextsimPhysics]")
 
 
 }
+
+TEST_CASE("Single precision forcing storage bounds the drift", "[NextsimPhysics]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+    tryConfigure(ModuleLoader::getLoader().getImplementation<IIceAlbedo>());
+
+    // Forcing values which are not exactly representable in single precision
+    const double tair = -12.3;
+    const double tdew = -12.7;
+    const double pair = 100123.4;
+    const double dml = 10.3;
+    const double lw = 265.1;
+    const double sw = 10.7;
+    const double snowfall = 1.1e-3;
+    const double wind = 5.3;
+
+    NextsimPhysics nsphys;
+    nsphys.configure();
+
+    // Calculates one timestep of the column. If single is true, the forcing
+    // and diagnostic fields are rounded to float, as in a MixedPrecision build.
+    auto column = [&](bool single) {
+        ElementData data(2);
+        data.configure();
+        data = PrognosticGenerator().hice(0.1).cice(0.5).sst(-1.75).sss(32).hsnow(0.01).tice(
+            { -9., -9. });
+        data.setTimestep(600.);
+
+        auto store = [single](double value) {
+            return single ? static_cast<double>(static_cast<float>(value)) : value;
+        };
+        data.setAirTemperature(store(tair));
+        data.setDewPoint2m(store(tdew));
+        data.setAirPressure(store(pair));
+        data.setMixedLayerDepth(store(dml));
+        data.setIncomingLongwave(store(lw));
+        data.setIncomingShortwave(store(sw));
+        data.setSnowfall(store(snowfall));
+        data.windSpeed() = store(wind);
+
+        nsphys.updateDerivedData(data, data, data);
+        data.airDensity() = store(data.airDensity());
+        data.specificHumidityAir() = store(data.specificHumidityAir());
+        data.specificHumidityWater() = store(data.specificHumidityWater());
+        data.specificHumidityIce() = store(data.specificHumidityIce());
+        data.heatCapacityWetAir() = store(data.heatCapacityWetAir());
+        nsphys.calculate(data, data, data);
+
+        return std::vector<double> { data.updatedIceTrueThickness(),
+            data.updatedSnowTrueThickness(), data.updatedIceConcentration(),
+            data.updatedIceSurfaceTemperature(), nsphys.QIceAtmosphere(),
+            nsphys.QIceOceanHeat() };
+    };
+
+    // The column calculated with double precision forcing and diagnostics.
+    // A MixedPrecision build rounds its storage even for the unrounded
+    // column, so it can only compare with these fixed values. They are
+    // compared as loosely as the drift bound, as other compilers, FMA
+    // contraction and other maths libraries change their last digits.
+    const std::vector<double> reference = { 0.19999535402883384, 0.021986241404448544,
+        0.50018657373476527, -9.1064122313788456, 47.003631984261794, 76.164903080515586 };
+    const std::vector<double> unrounded = column(false);
+    const std::vector<double> mixed = column(true);
+    for (size_t i = 0; i < reference.size(); ++i) {
+        // Single precision has a relative precision of 6e-8. Allow for some
+        // amplification of the rounding errors through the column physics.
+        REQUIRE(mixed[i] == Approx(unrounded[i]).epsilon(1e-5));
+        REQUIRE(unrounded[i] == Approx(reference[i]).epsilon(1e-5));
+        REQUIRE(mixed[i] == Approx(reference[i]).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("Modules are timed when configured", "[NextsimPhysics]")
+{
+    Configurator::clearStreams();
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "timing_interval = 2" << std::endl;
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ModuleLoader& loader = ModuleLoader::getLoader();
+    loader.setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+    REQUIRE(ModuleTiming::interval() == 2);
+    REQUIRE(dynamic_cast<TimedIceAlbedo*>(&loader.getImplementation<IIceAlbedo>()));
+
+    ScopedTimer::setTimerAddress(&Timer::main);
+    Timer::main.reset();
+
+    ElementData data(2);
+    data.configure();
+    const int nCalls = 6;
+    for (int i = 0; i < nCalls; ++i) {
+        data = PrognosticGenerator().hice(0.1).cice(0.5).sst(-1.75).sss(32).hsnow(0.01).tice(
+            { -9., -9. });
+        data.setTimestep(600.);
+        data.setAirTemperature(-12.);
+        data.setDewPoint2m(-12.5);
+        data.setAirPressure(100000.);
+        data.setMixedLayerDepth(10.);
+        data.setIncomingLongwave(265.);
+        data.setIncomingShortwave(10.);
+        data.setSnowfall(1e-3);
+        data.windSpeed() = 5.;
+
+        data.updateDerivedData(data, data, data);
+        data.calculate(data, data, data);
+    }
+
+    // Returns the number of ticks of the timer at the end of the path
+    std::stringstream csv;
+    Timer::main.reportCSV(csv);
+    auto ticks = [&csv](const std::string& path) {
+        std::string line;
+        csv.clear();
+        csv.seekg(0);
+        while (std::getline(csv, line)) {
+            size_t comma = line.find(',');
+            if (comma >= path.size()
+                && line.compare(comma - path.size(), path.size(), path) == 0)
+                return std::stoi(line.substr(comma + 1));
+        }
+        return 0;
+    };
+    // One in two of the calls to the column physics are timed, together with
+    // the modules called from within them
+    REQUIRE(ticks("/IPhysics1d::calculate") == nCalls / 2);
+    REQUIRE(ticks("/IPhysics1d::updateDerivedData") == nCalls / 2);
+    REQUIRE(ticks("/IPhysics1d::calculate/IThermodynamics::calculate") == nCalls / 2);
+    REQUIRE(ticks("/IPhysics1d::calculate/IIceOceanHeatFlux::flux") > 0);
+
+    ModuleTiming::setInterval(0);
+    Configurator::clearStreams();
+    REQUIRE_FALSE(dynamic_cast<TimedIceAlbedo*>(&loader.getImplementation<IIceAlbedo>()));
+}
 } /* namespace Nextsim */
@@ -0,0 +1,217 @@
+/*!
+ * @file ColumnDataset.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "ColumnDataset.hpp"
+
+#include "include/PrognosticGenerator.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace Nextsim {
+
+static const char signature[8] = { 'N', 'X', 'S', 'C', 'O', 'L', '0', '1' };
+// The prognostic fields before, and the forcing after, the ice temperatures
+static const std::vector<std::string> prognosticNames = { "hice", "cice", "hsnow", "sst", "sss" };
+static const std::vector<std::string> forcingNames
+    = { "tair", "dair", "slp", "mixrat", "Qsw_in", "Qlw_in", "mld", "snowfall", "wspeed" };
+
+std::vector<std::string> ColumnDataset::fieldNames(int nLayers)
+{
+    std::vector<std::string> names = prognosticNames;
+    for (int l = 0; l < nLayers; ++l) {
+        names.push_back("tice_" + std::to_string(l));
+    }
+    names.insert(names.end(), forcingNames.begin(), forcingNames.end());
+    return names;
+}
+
+std::vector<double> ColumnDataset::fields(const ElementData& column)
+{
+    std::vector<double> values = { column.iceThickness(), column.iceConcentration(),
+        column.snowThickness(), column.seaSurfaceTemperature(), column.seaSurfaceSalinity() };
+    for (int l = 0; l < column.nIceLayers(); ++l) {
+        values.push_back(column.iceTemperature(l));
+    }
+    const ExternalData& forcing = column;
+    const PhysicsData& physics = column;
+    values.insert(values.end(),
+        { forcing.airTemperature(), forcing.dewPoint2m(), forcing.airPressure(),
+            forcing.mixingRatio(), forcing.incomingShortwave(), forcing.incomingLongwave(),
+            forcing.mixedLayerDepth(), forcing.snowfall(), physics.windSpeed() });
+    return values;
+}
+
+void ColumnDataset::setFields(ElementData& column, const double* fields, int nLayers)
+{
+    column = PrognosticGenerator(nLayers)
+                 .hice(fields[0])
+                 .cice(fields[1])
+                 .hsnow(fields[2])
+                 .sst(fields[3])
+                 .sss(fields[4])
+                 .tice(std::vector<double>(fields + 5, fields + 5 + nLayers));
+    const double* forcing = fields + prognosticNames.size() + nLayers;
+    column.setAirTemperature(forcing[0]);
+    column.setDewPoint2m(forcing[1]);
+    column.setAirPressure(forcing[2]);
+    column.setMixingRatio(forcing[3]);
+    column.setIncomingShortwave(forcing[4]);
+    column.setIncomingLongwave(forcing[5]);
+    column.setMixedLayerDepth(forcing[6]);
+    column.setSnowfall(forcing[7]);
+    column.windSpeed() = forcing[8];
+}
+
+// Returns the number of ice layers shared by all the columns
+static int commonLayers(const std::vector<ElementData>& columns)
+{
+    const int nLayers = columns.empty() ? 1 : columns.front().nIceLayers();
+    for (const ElementData& column : columns) {
+        if (column.nIceLayers() != nLayers)
+            throw std::invalid_argument("ColumnDataset: the columns differ in their ice layers");
+    }
+    return nLayers;
+}
+
+void ColumnDataset::writeBinary(const std::vector<ElementData>& columns, std::ostream& os)
+{
+    const int32_t nLayers = commonLayers(columns);
+    const int64_t nColumns = columns.size();
+    os.write(signature, sizeof(signature));
+    os.write(reinterpret_cast<const char*>(&nColumns), sizeof(nColumns));
+    os.write(reinterpret_cast<const char*>(&nLayers), sizeof(nLayers));
+    for (const ElementData& column : columns) {
+        const std::vector<double> values = fields(column);
+        os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    }
+}
+
+std::vector<ElementData> ColumnDataset::readBinary(std::istream& is)
+{
+    char fileSignature[sizeof(signature)];
+    int64_t nColumns;
+    int32_t nLayers;
+    is.read(fileSignature, sizeof(fileSignature));
+    is.read(reinterpret_cast<char*>(&nColumns), sizeof(nColumns));
+    is.read(reinterpret_cast<char*>(&nLayers), sizeof(nLayers));
+    if (!is || std::memcmp(fileSignature, signature, sizeof(signature)) != 0 || nColumns < 0
+        || nLayers <= 0 || nLayers > maxLayers)
+        throw std::invalid_argument("ColumnDataset: not a binary column dataset");
+
+    const std::string truncated = "ColumnDataset: the binary column dataset is truncated";
+    const size_t nFields = prognosticNames.size() + nLayers + forcingNames.size();
+    const size_t columnBytes = nFields * sizeof(double);
+    // Where the stream can tell its size, check that it holds all the columns
+    // before allocating them, so that a corrupt header fails at once
+    std::vector<ElementData> columns;
+    const std::streampos start = is.tellg();
+    if (start != std::streampos(-1)) {
+        is.seekg(0, std::ios::end);
+        const std::streamoff remaining = is.tellg() - start;
+        is.seekg(start);
+        if (!is || remaining < 0
+            || static_cast<uint64_t>(nColumns) > static_cast<uint64_t>(remaining) / columnBytes)
+            throw std::invalid_argument(truncated);
+        columns.reserve(nColumns);
+    }
+
+    std::vector<double> values(nFields);
+    for (int64_t i = 0; i < nColumns; ++i) {
+        if (!is.read(reinterpret_cast<char*>(values.data()), columnBytes))
+            throw std::invalid_argument(truncated);
+        columns.emplace_back(nLayers);
+        setFields(columns.back(), values.data(), nLayers);
+    }
+    return columns;
+}
+
+void ColumnDataset::writeCSV(const std::vector<ElementData>& columns, std::ostream& os)
+{
+    const std::vector<std::string> names = fieldNames(commonLayers(columns));
+    for (size_t i = 0; i < names.size(); ++i) {
+        os << (i > 0 ? "," : "") << names[i];
+    }
+    os << std::endl;
+    const auto precision = os.precision(std::numeric_limits<double>::max_digits10);
+    for (const ElementData& column : columns) {
+        const std::vector<double> values = fields(column);
+        for (size_t i = 0; i < values.size(); ++i) {
+            os << (i > 0 ? "," : "") << values[i];
+        }
+        os << "\n";
+    }
+    os.precision(precision);
+}
+
+std::vector<ElementData> ColumnDataset::readCSV(std::istream& is)
+{
+    std::string line;
+    std::getline(is, line);
+    std::stringstream header(line);
+    std::vector<std::string> names;
+    std::string name;
+    while (std::getline(header, name, ',')) {
+        names.push_back(name);
+    }
+    const int nLayers = static_cast<int>(names.size())
+        - static_cast<int>(prognosticNames.size() + forcingNames.size());
+    if (nLayers <= 0 || names != fieldNames(nLayers))
+        throw std::invalid_argument("ColumnDataset: the CSV header does not name the fields");
+
+    std::vector<ElementData> columns;
+    std::vector<double> values(names.size());
+    while (std::getline(is, line)) {
+        if (line.empty())
+            continue;
+        std::stringstream fieldStream(line);
+        std::string field;
+        size_t i = 0;
+        while (std::getline(fieldStream, field, ',')) {
+            if (i == values.size())
+                throw std::invalid_argument("ColumnDataset: too many values in line: " + line);
+            values[i++] = std::stod(field);
+        }
+        if (i != values.size())
+            throw std::invalid_argument("ColumnDataset: too few values in line: " + line);
+        columns.emplace_back(nLayers);
+        setFields(columns.back(), values.data(), nLayers);
+    }
+    return columns;
+}
+
+static bool isCSV(const std::string& fileName)
+{
+    const std::string extension = ".csv";
+    return fileName.size() >= extension.size()
+        && fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+std::vector<ElementData> ColumnDataset::read(const std::string& fileName)
+{
+    std::ifstream file(fileName, isCSV(fileName) ? std::ios::in : std::ios::binary);
+    if (!file)
+        throw std::invalid_argument("ColumnDataset: could not open " + fileName);
+    return isCSV(fileName) ? readCSV(file) : readBinary(file);
+}
+
+void ColumnDataset::write(const std::vector<ElementData>& columns, const std::string& fileName)
+{
+    std::ofstream file(fileName, isCSV(fileName) ? std::ios::out : std::ios::binary);
+    if (!file)
+        throw std::invalid_argument("ColumnDataset: could not open " + fileName);
+    if (isCSV(fileName)) {
+        writeCSV(columns, file);
+    } else {
+        writeBinary(columns, file);
+    }
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,92 @@
+/*!
+ * @file ColumnDataset.hpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#ifndef PROXY_COLUMNDATASET_HPP
+#define PROXY_COLUMNDATASET_HPP
+
+#include "include/ElementData.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class reading and writing sets of independent columns.
+ *
+ * @details Each column holds its prognostic fields, the temperature of each
+ * ice layer and its forcing, the state from which the column physics starts.
+ * All the columns of a dataset have the same number of ice layers. The
+ * fields are named by fieldNames().
+ *
+ * The binary format is an eight byte signature, the number of columns as a
+ * 64 bit integer and the number of ice layers as a 32 bit integer, followed
+ * by the fields of each column in turn as doubles, all in the native byte
+ * order. The CSV format has a header line of the field names, then one line
+ * per column.
+ */
+class ColumnDataset {
+public:
+    //! The largest number of ice layers of a column that the readers accept.
+    static const int maxLayers = 1000;
+
+    /*!
+     * @brief Returns the names of the fields of each column.
+     *
+     * @param nLayers The number of ice layers of the columns.
+     */
+    static std::vector<std::string> fieldNames(int nLayers);
+
+    /*!
+     * @brief Writes columns in the binary format.
+     *
+     * @details Throws std::invalid_argument if the columns differ in their
+     * number of ice layers.
+     *
+     * @param columns The columns to be written.
+     * @param os The ostream to write to, which should be opened in binary mode.
+     */
+    static void writeBinary(const std::vector<ElementData>& columns, std::ostream& os);
+    /*!
+     * @brief Reads columns in the binary format.
+     *
+     * @details Throws std::invalid_argument if the stream does not hold a
+     * complete dataset, or its columns have more than maxLayers ice layers.
+     *
+     * @param is The istream to read from, which should be opened in binary mode.
+     */
+    static std::vector<ElementData> readBinary(std::istream& is);
+
+    //! Writes columns in the CSV format.
+    static void writeCSV(const std::vector<ElementData>& columns, std::ostream& os);
+    /*!
+     * @brief Reads columns in the CSV format.
+     *
+     * @details Throws std::invalid_argument if the header does not name the
+     * fields of fieldNames() or a line does not hold a value for each field.
+     */
+    static std::vector<ElementData> readCSV(std::istream& is);
+
+    /*!
+     * @brief Reads columns from a file, in CSV format if its name ends in
+     * ".csv" and in binary format otherwise.
+     */
+    static std::vector<ElementData> read(const std::string& fileName);
+    //! Writes columns to a file, in CSV format if its name ends in ".csv".
+    static void write(const std::vector<ElementData>& columns, const std::string& fileName);
+
+private:
+    // Returns the fields of a column in the order of fieldNames()
+    static std::vector<double> fields(const ElementData& column);
+    // Sets a column from its fields in the order of fieldNames()
+    static void setFields(ElementData& column, const double* fields, int nLayers);
+};
+
+} /* namespace Nextsim */
+
+#endif /* PROXY_COLUMNDATASET_HPP */
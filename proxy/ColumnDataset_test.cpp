@@ -0,0 +1,133 @@
+/*!
+ * @file ColumnDataset_test.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "ColumnDataset.hpp"
+
+#include "include/ElementData.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticGenerator.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+static std::vector<ElementData> twoLayerColumns()
+{
+    std::vector<ElementData> columns(3);
+    for (int i = 0; i < 3; ++i) {
+        columns[i] = PrognosticGenerator(2)
+                         .hice(0.5 * i)
+                         .cice(0.3 * i)
+                         .hsnow(0.1 / 3)
+                         .sst(-1.8)
+                         .sss(33.2)
+                         .tice({ -10. - i, -5 });
+        columns[i].setAirTemperature(-12 + i);
+        columns[i].setDewPoint2m(-14);
+        columns[i].setAirPressure(101000);
+        columns[i].setMixingRatio(-1);
+        columns[i].setIncomingShortwave(50);
+        columns[i].setIncomingLongwave(250);
+        columns[i].setMixedLayerDepth(10);
+        columns[i].setSnowfall(1e-5);
+        columns[i].windSpeed() = 5 + i;
+    }
+    return columns;
+}
+
+static void requireEqual(const std::vector<ElementData>& read,
+    const std::vector<ElementData>& written)
+{
+    REQUIRE(read.size() == written.size());
+    for (size_t i = 0; i < read.size(); ++i) {
+        REQUIRE(read[i].nIceLayers() == 2);
+        REQUIRE(read[i].iceThickness() == written[i].iceThickness());
+        REQUIRE(read[i].iceConcentration() == written[i].iceConcentration());
+        REQUIRE(read[i].snowThickness() == written[i].snowThickness());
+        REQUIRE(read[i].iceTemperature(0) == written[i].iceTemperature(0));
+        REQUIRE(read[i].iceTemperature(1) == written[i].iceTemperature(1));
+        REQUIRE(read[i].airTemperature() == written[i].airTemperature());
+        REQUIRE(static_cast<const ExternalData&>(read[i]).mixingRatio()
+            == static_cast<const ExternalData&>(written[i]).mixingRatio());
+        REQUIRE(read[i].snowfall() == written[i].snowfall());
+        REQUIRE(static_cast<const PhysicsData&>(read[i]).windSpeed()
+            == static_cast<const PhysicsData&>(written[i]).windSpeed());
+    }
+}
+
+TEST_CASE("Column datasets in the binary format", "[ColumnDataset]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    std::vector<ElementData> columns = twoLayerColumns();
+
+    std::stringstream binary;
+    ColumnDataset::writeBinary(columns, binary);
+    requireEqual(ColumnDataset::readBinary(binary), columns);
+
+    // A truncated dataset
+    std::string truncated = binary.str();
+    truncated.resize(truncated.size() - 1);
+    std::stringstream truncatedStream(truncated);
+    REQUIRE_THROWS_AS(ColumnDataset::readBinary(truncatedStream), std::invalid_argument);
+
+    // A corrupt header claiming far more columns than the data holds fails
+    // before allocating them
+    std::string corrupt = binary.str();
+    const int64_t manyColumns = int64_t(1) << 40;
+    corrupt.replace(8, sizeof(manyColumns), reinterpret_cast<const char*>(&manyColumns),
+        sizeof(manyColumns));
+    std::stringstream corruptStream(corrupt);
+    REQUIRE_THROWS_AS(ColumnDataset::readBinary(corruptStream), std::invalid_argument);
+
+    // As does a corrupt header claiming an unbounded number of layers of no
+    // columns
+    std::string noColumns = binary.str().substr(0, 20);
+    const int64_t zero = 0;
+    const int32_t manyLayers = std::numeric_limits<int32_t>::max();
+    noColumns.replace(8, sizeof(zero), reinterpret_cast<const char*>(&zero), sizeof(zero));
+    noColumns.replace(16, sizeof(manyLayers), reinterpret_cast<const char*>(&manyLayers),
+        sizeof(manyLayers));
+    std::stringstream noColumnsStream(noColumns);
+    REQUIRE_THROWS_AS(ColumnDataset::readBinary(noColumnsStream), std::invalid_argument);
+
+    std::stringstream notADataset("hice,cice");
+    REQUIRE_THROWS_AS(ColumnDataset::readBinary(notADataset), std::invalid_argument);
+}
+
+TEST_CASE("Column datasets in the CSV format", "[ColumnDataset]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    std::vector<ElementData> columns = twoLayerColumns();
+
+    std::stringstream csv;
+    ColumnDataset::writeCSV(columns, csv);
+    // The values are written exactly
+    requireEqual(ColumnDataset::readCSV(csv), columns);
+
+    REQUIRE(ColumnDataset::fieldNames(2).size() == 16);
+    REQUIRE(ColumnDataset::fieldNames(2)[6] == "tice_1");
+
+    std::stringstream badHeader("hice,cice,hsnow\n1,2,3\n");
+    REQUIRE_THROWS_AS(ColumnDataset::readCSV(badHeader), std::invalid_argument);
+
+    std::stringstream shortLine;
+    ColumnDataset::writeCSV({}, shortLine);
+    shortLine << "1,2,3" << std::endl;
+    REQUIRE_THROWS_AS(ColumnDataset::readCSV(shortLine), std::invalid_argument);
+
+    std::vector<ElementData> mixedLayers = twoLayerColumns();
+    mixedLayers.emplace_back(1);
+    REQUIRE_THROWS_AS(ColumnDataset::writeCSV(mixedLayers, csv), std::invalid_argument);
+}
+
+} /* namespace Nextsim */
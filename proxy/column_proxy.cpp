@@ -0,0 +1,176 @@
+/*!
+ * @file column_proxy.cpp
+ *
+ * @date Oct 19, 2026
+ *
+ * A proxy of the column physics of the model. It reads a set of independent
+ * columns (see ColumnDataset) and steps them with DevStep::stepColumns(),
+ * the column loop of the model: the derived quantities, the derived data of
+ * IPhysics1d, the fluxes and ThermoIce0 thermodynamics, and the integration
+ * of each column in turn. There is no Model, configuration file, structure
+ * or restart file, so that the physics alone can be built with other
+ * compiler flags, vectorized or threaded and profiled. The columns are
+ * divided into one contiguous block per thread. The time of the column
+ * physics is that of the slowest thread, and its throughput is written to
+ * standard output as CSV. The time of each stage within the column loop can
+ * be found by profiling the proxy.
+ *
+ * With --generate, a dataset of the given number of columns is written from
+ * a SyntheticDomain instead.
+ *
+ * Usage: nextsim_column_proxy columns.bin [--steps 10] [--threads 1] [--timestep 3600]
+ *        nextsim_column_proxy --generate columns.bin [--columns 1000000] [--layers 1]
+ *                             [--seed 1]
+ */
+
+#include "ColumnDataset.hpp"
+#include "SyntheticDomain.hpp"
+
+#include "include/DevStep.hpp"
+#include "include/ElementData.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticData.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Settings {
+    std::string fileName;
+    bool generate = false;
+    long columns = 1000000;
+    int layers = 1;
+    unsigned seed = 1;
+    int steps = 10;
+    int threads = 1;
+    double timestep = 3600;
+};
+
+Settings parseArguments(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option.compare(0, 2, "--") != 0) {
+            settings.fileName = option;
+            continue;
+        }
+        if (option == "--generate") {
+            settings.generate = true;
+            continue;
+        }
+        if (i + 1 == argc)
+            throw std::invalid_argument("No value given for " + option);
+        const std::string value = argv[++i];
+        if (option == "--columns") {
+            settings.columns = std::stol(value);
+        } else if (option == "--layers") {
+            settings.layers = std::stoi(value);
+        } else if (option == "--seed") {
+            settings.seed = std::stoul(value);
+        } else if (option == "--steps") {
+            settings.steps = std::stoi(value);
+        } else if (option == "--threads") {
+            settings.threads = std::stoi(value);
+        } else if (option == "--timestep") {
+            settings.timestep = std::stod(value);
+        } else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+    if (settings.fileName.empty())
+        throw std::invalid_argument("No column dataset given");
+    if (settings.columns <= 0 || settings.steps <= 0 || settings.threads <= 0)
+        throw std::invalid_argument("The columns, steps and threads must be positive");
+    return settings;
+}
+
+void configureModules()
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    Nextsim::ElementData().configure();
+}
+
+// Writes the columns of a roughly square SyntheticDomain
+void generate(const Settings& settings)
+{
+    const int nx = std::max(1, static_cast<int>(std::sqrt(settings.columns)));
+    const int ny = (settings.columns + nx - 1) / nx;
+    std::vector<Nextsim::ElementData> columns;
+    Nextsim::SyntheticDomain(nx, ny, settings.layers, settings.seed).fill(columns);
+    columns.resize(settings.columns);
+    Nextsim::ColumnDataset::write(columns, settings.fileName);
+    std::cerr << "Wrote " << columns.size() << " columns to " << settings.fileName << std::endl;
+}
+
+void run(const Settings& settings)
+{
+    std::vector<Nextsim::ElementData> columns = Nextsim::ColumnDataset::read(settings.fileName);
+    Nextsim::PrognosticData::setTimestep(settings.timestep);
+
+    typedef std::chrono::steady_clock Clock;
+    // The time of the column physics on each thread
+    std::vector<double> seconds(settings.threads, 0);
+    auto worker = [&](int thread) {
+        const size_t begin = columns.size() * thread / settings.threads;
+        const size_t end = columns.size() * (thread + 1) / settings.threads;
+        const Clock::time_point start = Clock::now();
+        for (int step = 0; step < settings.steps; ++step) {
+            Nextsim::DevStep::stepColumns(columns.data() + begin, columns.data() + end);
+        }
+        seconds[thread] = std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 1; t < settings.threads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const double columnSteps = static_cast<double>(columns.size()) * settings.steps;
+    std::cout << "pass,columns,threads,steps,seconds,ns_per_column,columns_per_s" << std::endl;
+    auto writePass = [&](const std::string& name, double passSeconds) {
+        std::cout << "\"" << name << "\"," << columns.size() << "," << settings.threads << ","
+                  << settings.steps << "," << passSeconds << ","
+                  << 1e9 * passSeconds * settings.threads / columnSteps << ","
+                  << columnSteps / passSeconds << std::endl;
+    };
+    writePass("column physics", *std::max_element(seconds.begin(), seconds.end()));
+    writePass("total", wallSeconds);
+}
+
+} /* anonymous namespace */
+
+int main(int argc, char* argv[])
+{
+    try {
+        Settings settings = parseArguments(argc, argv);
+        configureModules();
+        if (settings.generate) {
+            generate(settings);
+        } else {
+            run(settings);
+        }
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << "Usage: " << argv[0]
+                  << " columns.bin [--steps 10] [--threads 1] [--timestep 3600]" << std::endl
+                  << "       " << argv[0]
+                  << " --generate columns.bin [--columns 1000000] [--layers 1] [--seed 1]"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}